@@ -1,62 +1,133 @@
 #include "Blob.hpp"
 #include "helpers/Matrix.hpp"
 #include "helpers/ProgressBar.hpp"
+#include "helpers/Simd.hpp"
+#include "helpers/ThreadPool.hpp"
 #include "Filter.hpp"
+#include "ScaleSpace.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <vector>
 #include <tuple>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace VisualAlgo::FeatureExtraction
 {
-    std::vector<std::tuple<int, int, float>> Blob::findLocalMaxima(const std::vector<Matrix> &scale_space, const std::vector<float> &sigmas, int window_size, float threshold) const
+    // Rows of a level searched for maxima by one task
+    static const int BAND_ROWS = 64;
+
+    std::vector<std::tuple<int, int, float>> Blob::findLocalMaxima(const std::vector<Matrix> &scale_space, const std::vector<int> &factors, const std::vector<float> &sigmas, int window_size, float threshold) const
     {
         if (window_size % 2 == 0)
             throw std::invalid_argument("Window size must be odd.");
 
-        const int ROWS = scale_space.front().rows;
-        const int COLS = scale_space.front().cols;
-
-        std::vector<std::tuple<int, int, float>> maxima;
         int half_window = window_size / 2;
+        MaxFilter max_filter(window_size);
 
+        // One task per band of rows of each level, their maxima are joined
+        // in the order of the tasks whatever thread ran them
+        std::vector<std::pair<int, int>> bands; // (level, first row)
         for (size_t iter = 0; iter < scale_space.size(); ++iter)
         {
+            const Matrix &matrix = scale_space[iter];
+            if (matrix.rows <= 2 * half_window || matrix.cols <= 2 * half_window)
+                continue;
+            for (int row = half_window; row < matrix.rows - half_window; row += BAND_ROWS)
+                bands.emplace_back(iter, row);
+        }
+        std::vector<std::vector<std::tuple<int, int, float>>> band_maxima(bands.size());
+
+        ThreadPool::global().parallel_for(bands.size(), [&](int band)
+                                          {
+            const size_t iter = bands[band].first;
             Matrix const &matrix = scale_space[iter];
+            const int ROWS = matrix.rows;
+            const int COLS = matrix.cols;
+            const int factor = factors[iter];
+            const int band_rows_end = std::min(bands[band].second + BAND_ROWS, ROWS - half_window);
 
-            int scale_window = std::min((size_t)half_window, std::min(iter, scale_space.size() - iter - 1));
+            // Only rows with a value above the threshold can hold maxima, the
+            // maximum filters only run on those rows and their windows
+            int first = ROWS, last = -1;
+            for (int i = bands[band].second; i < band_rows_end; i++)
+            {
+                if (Simd::max(matrix[i] + half_window, COLS - 2 * half_window) > threshold)
+                {
+                    first = std::min(first, i);
+                    last = i;
+                }
+            }
+            if (last < 0)
+                return;
+            const int band_start = first - half_window;
+            const int band_end = last + half_window + 1;
 
-            for (int i = half_window; i < ROWS - half_window; i++)
+            // Maximum over the neighboring levels, sampled at the nearest
+            // pixel when they are at another resolution, then over the
+            // window_size x window_size window: a point is a maximum when it
+            // equals the maximum of its 3D neighborhood
+            int scale_window = std::min((size_t)half_window, std::min(iter, scale_space.size() - iter - 1));
+            Matrix scale_max = matrix.submatrix(band_start, band_end, 0, COLS);
+            for (int si = -scale_window; si <= scale_window; si++)
             {
-                for (int j = half_window; j < COLS - half_window; j++)
+                if (si == 0)
+                    continue;
+                const Matrix &neighbor = scale_space[iter + si];
+                const int neighbor_factor = factors[iter + si];
+                for (int r = 0; r < scale_max.rows; r++)
                 {
-                    float currVal = matrix.get(i, j);
-                    bool isMaxima = true;
-                    for (int si = -scale_window; si <= scale_window && isMaxima; si++)
+                    float *out = scale_max[r];
+                    if (neighbor_factor == factor)
                     {
-                        for (int xi = -half_window; xi <= half_window && isMaxima; xi++)
-                        {
-                            for (int yi = -half_window; yi <= half_window && isMaxima; yi++)
-                            {
-                                if (scale_space[iter + si].get(i + xi, j + yi) > currVal)
-                                {
-                                    isMaxima = false;
-                                    break;
-                                }
-                            }
-                        }
+                        Simd::maximum(out, neighbor[band_start + r], out, COLS);
+                        continue;
                     }
+                    const float *in = neighbor[std::min((band_start + r) * factor / neighbor_factor, neighbor.rows - 1)];
+                    for (int j = 0; j < COLS; j++)
+                        out[j] = std::max(out[j], in[std::min(j * factor / neighbor_factor, neighbor.cols - 1)]);
+                }
+            }
+            Matrix window_max = max_filter.apply(scale_max);
 
-                    if (isMaxima && currVal > threshold)
-                    {
-                        maxima.push_back(std::make_tuple(i, j, sigmas[iter]));
-                    }
+            for (int i = first; i <= last; i++)
+            {
+                const float *values = matrix[i];
+                const float *max_values = window_max[i - band_start];
+                for (int j = half_window; j < COLS - half_window; j++)
+                {
+                    if (values[j] > threshold && values[j] == max_values[j])
+                        band_maxima[band].push_back(std::make_tuple(i * factor, j * factor, sigmas[iter]));
                 }
+            } });
+
+        std::vector<std::tuple<int, int, float>> maxima;
+        for (const auto &found : band_maxima)
+            maxima.insert(maxima.end(), found.begin(), found.end());
+        return maxima;
+    }
+
+    // LoGFilter divides its kernel by the sum of its taps, which scales the
+    // Laplacian of Gaussian by 2 pi sigma^6 / sum (a negative number, so
+    // bright blobs give maxima). BlobLoG thresholds are relative to that
+    // scale, so the scale space response is scaled the same way.
+    static float log_filter_scale(float sigma)
+    {
+        int size = 2 * ceil(3 * sigma) + 1;
+        float sum = 0.0f;
+        for (int i = 0; i < size; i++)
+        {
+            int x = i - size / 2;
+            for (int j = 0; j < size; j++)
+            {
+                int y = j - size / 2;
+                sum += (x * x + y * y - 2 * sigma * sigma) * exp(-(x * x + y * y) / (2 * sigma * sigma));
             }
         }
-        return maxima;
+        return 2 * M_PI * pow(sigma, 6) / sum;
     }
 
     BlobDoG::BlobDoG(float initial_sigma, float k, float threshold, int window_size, int octaves)
@@ -91,28 +162,42 @@ namespace VisualAlgo::FeatureExtraction
 
     std::vector<std::tuple<int, int, float>> BlobDoG::detect(const Matrix &image) const
     {
-        ProgressBar progress_bar(octaves + 1, "BlobDoG detection");
-        std::vector<Matrix> DoG_space;
+        ProgressBar progress_bar(2, "BlobDoG detection");
+        std::vector<float> gaussian_sigmas;
         float sigma = initial_sigma;
-        Matrix prev_blurred;
-        std::vector<float> sigmas;
-
         for (int i = 0; i < octaves + 1; i++)
         {
-            GaussianFilter g(sigma);
-            Matrix blurred = g.apply(image);
-            if (i > 0)
-            {
-                progress_bar.step("Applying DoG filter of sigma = " + std::to_string(sigma) + "...");
-                DoG_space.push_back((blurred - prev_blurred) * (sigma * sigma));
-            }
-            prev_blurred = blurred;
+            gaussian_sigmas.push_back(sigma);
             sigma *= k;
-            sigmas.push_back(sigma);
         }
 
+        // Each octave is blurred from the previous one, coarser levels at a lower resolution
+        ScaleSpace space(image, gaussian_sigmas);
+        std::vector<int> factors;
+        std::vector<float> sigmas;
+        std::vector<std::pair<int, int>> gaussians; // (level, factor) of the Gaussians of the differences
+        for (int i = 0; i < octaves; i++)
+        {
+            factors.push_back(space.dog_factor(i));
+            sigmas.push_back(gaussian_sigmas[i + 1]);
+            gaussians.emplace_back(i, factors[i]);
+            gaussians.emplace_back(i + 1, factors[i]);
+        }
+        std::sort(gaussians.begin(), gaussians.end());
+        gaussians.erase(std::unique(gaussians.begin(), gaussians.end()), gaussians.end());
+
+        // Each Gaussian is blurred once before the differences read them; the
+        // levels of an octave wait for each other, their bands run on the pool
+        progress_bar.step("Applying DoG filters...");
+        ThreadPool &pool = ThreadPool::global();
+        pool.parallel_for(gaussians.size(), [&](int n)
+                          { space.gaussian(gaussians[n].first, gaussians[n].second); });
+        std::vector<Matrix> DoG_space(octaves);
+        pool.parallel_for(octaves, [&](int i)
+                          { DoG_space[i] = space.dog(i) * (sigmas[i] * sigmas[i]); });
+
         progress_bar.step("Finding local maxima...");
-        return findLocalMaxima(DoG_space, sigmas, window_size, threshold);
+        return findLocalMaxima(DoG_space, factors, sigmas, window_size, threshold);
     }
 
     BlobLoG::BlobLoG(float initial_sigma, float k, float threshold, int window_size, int octaves)
@@ -147,24 +232,28 @@ namespace VisualAlgo::FeatureExtraction
 
     std::vector<std::tuple<int, int, float>> BlobLoG::detect(const Matrix &image) const
     {
-        ProgressBar progress_bar(octaves + 1, "BlobLoG detection");
-        std::vector<Matrix> LoG_space;
-        float sigma = initial_sigma;
+        ProgressBar progress_bar(2, "BlobLoG detection");
         std::vector<float> sigmas;
-        sigmas.push_back(sigma);
-
+        float sigma = initial_sigma;
         for (int i = 0; i < octaves; i++)
         {
-            progress_bar.step("Applying LoG filter of sigma = " + std::to_string(sigma) + "...");
-            LoGFilter g(sigma);
-            Matrix LoG = g.apply(image);
-            LoG_space.push_back(LoG * (sigma * sigma));
-            sigma *= k;
             sigmas.push_back(sigma);
+            sigma *= k;
         }
 
+        // The Laplacian of each Gaussian of the scale space instead of a LoG
+        // filter per level
+        ScaleSpace space(image, sigmas);
+        std::vector<Matrix> LoG_space(octaves);
+        std::vector<int> factors;
+        for (int i = 0; i < octaves; i++)
+            factors.push_back(space.factor(i));
+        progress_bar.step("Applying LoG filters...");
+        ThreadPool::global().parallel_for(octaves, [&](int i)
+                                          { LoG_space[i] = space.laplacian(i) * (sigmas[i] * sigmas[i] * log_filter_scale(sigmas[i])); });
+
         progress_bar.step("Finding local maxima...");
-        return findLocalMaxima(LoG_space, sigmas, window_size, threshold);
+        return findLocalMaxima(LoG_space, factors, sigmas, window_size, threshold);
     }
 
-}
\ No newline at end of file
+}
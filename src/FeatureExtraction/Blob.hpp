@@ -18,7 +18,10 @@ namespace VisualAlgo::FeatureExtraction
         virtual std::vector<std::tuple<int, int, float>> detect(const Matrix &image) const = 0;
 
     protected:
-        std::vector<std::tuple<int, int, float>> findLocalMaxima(const std::vector<Matrix> &scale_space, const std::vector<float> &sigmas, int window_size, float threshold) const;
+        // Levels may be stored at different resolutions, level n at 1 / factors[n]
+        // of the image. Windows are in pixels of each level, neighboring levels
+        // are sampled at the nearest pixel and maxima are returned in image pixels.
+        std::vector<std::tuple<int, int, float>> findLocalMaxima(const std::vector<Matrix> &scale_space, const std::vector<int> &factors, const std::vector<float> &sigmas, int window_size, float threshold) const;
     };
 
     class BlobDoG : public Blob
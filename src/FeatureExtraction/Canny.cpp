@@ -68,20 +68,23 @@ namespace VisualAlgo::FeatureExtraction
 
         for (int i = 1; i < image.rows - 1; i++)
         {
+            // The 3x3 neighborhood through three row pointers, without bounds checks
+            const float *above = image[i - 1], *row = image[i], *below = image[i + 1];
+            float *out = edges[i];
             for (int j = 1; j < image.cols - 1; j++)
             {
-                if (image.get(i, j) == 255)
+                if (row[j] == 255)
                 {
-                    edges.set(i, j, 255); // Strong edge
+                    out[j] = 255; // Strong edge
                 }
                 // If the pixel is a weak edge but has a strong edge in its 8-connected neighborhood, set it in the output image
-                else if (image.get(i, j) == 128)
+                else if (row[j] == 128)
                 {
-                    if ((image.get(i - 1, j - 1) == 255) || (image.get(i - 1, j) == 255) || (image.get(i - 1, j + 1) == 255) ||
-                        (image.get(i, j - 1) == 255) || (image.get(i, j + 1) == 255) ||
-                        (image.get(i + 1, j - 1) == 255) || (image.get(i + 1, j) == 255) || (image.get(i + 1, j + 1) == 255))
+                    if ((above[j - 1] == 255) | (above[j] == 255) | (above[j + 1] == 255) |
+                        (row[j - 1] == 255) | (row[j + 1] == 255) |
+                        (below[j - 1] == 255) | (below[j] == 255) | (below[j + 1] == 255))
                     {
-                        edges.set(i, j, 255);
+                        out[j] = 255;
                     }
                 }
             }
@@ -1,6 +1,12 @@
 #pragma once
 
 #include "helpers/Matrix.hpp"
+#include "helpers/BasicMatrix.hpp"
+#include "helpers/KernelCache.hpp"
+
+#include <string>
+#include <type_traits>
+#include <utility>
 
 namespace VisualAlgo::FeatureExtraction
 {
@@ -8,28 +14,70 @@ namespace VisualAlgo::FeatureExtraction
     class Filter
     {
     public:
-        virtual Matrix apply(const Matrix &image) const = 0;
+        virtual Matrix apply(const MatrixView &image) const = 0; // the default border handling of the filter
+        virtual Matrix apply(const MatrixView &image, BorderMode border, float value = 0) const = 0; // value is used by BorderMode::CONSTANT
+
+        // An element-wise expression (see MatrixExpr.hpp), e.g. filter.apply(a * b),
+        // is evaluated into a Matrix first: a view cannot own the result.
+        // Subclasses bring these in with `using Filter::apply`.
+        template <typename E>
+            requires MatrixExpression<std::remove_cvref_t<E>>
+        Matrix apply(E &&image) const
+        {
+            return this->apply(Matrix(std::forward<E>(image)));
+        }
+        template <typename E>
+            requires MatrixExpression<std::remove_cvref_t<E>>
+        Matrix apply(E &&image, BorderMode border, float value = 0) const
+        {
+            return this->apply(Matrix(std::forward<E>(image)), border, value);
+        }
 
     protected:
         Matrix kernel;
     };
 
+    // How GaussianFilter smooths an image
+    enum class GaussianMethod
+    {
+        AUTO,     // RECURSIVE from RECURSIVE_GAUSSIAN_MIN_SIGMA on, KERNEL below
+        KERNEL,   // sampled kernel of 2 * ceil(3 * sigma) + 1 taps, as two 1D passes
+        RECURSIVE // third-order recursive filter run forward and backward (Young, van Vliet and van Ginkel, 2002), sigma >= 1
+    };
+
+    std::string to_string(GaussianMethod method);
+
+    // The kernel costs 2 * (6 * sigma + 1) multiply-adds per pixel, the
+    // recursive filter a constant 8, but its response is only within about
+    // 2% of the Gaussian. The crossover in speed is around this sigma.
+    constexpr float RECURSIVE_GAUSSIAN_MIN_SIGMA = 12.0f;
+
     class GaussianFilter : public Filter
     {
     public:
-        GaussianFilter(float sigma);
-        virtual Matrix apply(const Matrix &image) const override;
+        using Filter::apply;
+        GaussianFilter(float sigma, GaussianMethod method = GaussianMethod::KERNEL);
+        virtual Matrix apply(const MatrixView &image) const override; // BorderMode::REFLECT_101
+        virtual Matrix apply(const MatrixView &image, BorderMode border, float value = 0) const override;
+
+        GaussianMethod applied_method() const; // KERNEL or RECURSIVE, never AUTO
+        const Matrix &taps() const;            // the 1D kernel that KERNEL applies along rows and then columns, one row; throws for RECURSIVE
 
     private:
         float sigma;
-        Matrix computeGaussianKernel(float sigma) const;
+        GaussianMethod method; // never AUTO
+        KernelCache::Kernel kernel_1d; // the 2D kernel is kernel_1d^T * kernel_1d, applied as two 1D passes; null for RECURSIVE
+        Matrix computeGaussianKernel1D(float sigma) const;
+        Matrix applyRecursive(const MatrixView &image, BorderMode border, float value) const;
     };
 
     class SobelFilterX : public Filter
     {
     public:
+        using Filter::apply;
         SobelFilterX();
-        virtual Matrix apply(const Matrix &image) const override;
+        virtual Matrix apply(const MatrixView &image) const override; // BorderMode::REFLECT_101
+        virtual Matrix apply(const MatrixView &image, BorderMode border, float value = 0) const override;
 
     private:
         Matrix sobelX = Matrix({{1, 0, -1},
@@ -40,8 +88,10 @@ namespace VisualAlgo::FeatureExtraction
     class SobelFilterY : public Filter
     {
     public:
+        using Filter::apply;
         SobelFilterY();
-        virtual Matrix apply(const Matrix &image) const override;
+        virtual Matrix apply(const MatrixView &image) const override; // BorderMode::REFLECT_101
+        virtual Matrix apply(const MatrixView &image, BorderMode border, float value = 0) const override;
 
     private:
         Matrix sobelY = Matrix({{1, 2, 1},
@@ -52,23 +102,44 @@ namespace VisualAlgo::FeatureExtraction
     class LoGFilter : public Filter
     {
     public:
+        using Filter::apply;
         LoGFilter(float sigma);
-        virtual Matrix apply(const Matrix &image) const override;
+        virtual Matrix apply(const MatrixView &image) const override; // BorderMode::REFLECT_101
+        virtual Matrix apply(const MatrixView &image, BorderMode border, float value = 0) const override;
     private:
         float sigma;
-        Matrix kernel;
+        KernelCache::Kernel shared_kernel; // in place of Filter::kernel, which stays empty
         Matrix computeLoGKernel(float sigma) const;
     };
 
     class MedianFilter : public Filter
     {
     public:
+        using Filter::apply;
         MedianFilter(int size);
-        virtual Matrix apply(const Matrix &image) const override;
+        virtual Matrix apply(const MatrixView &image) const override; // the window shrinks at the border
+        virtual Matrix apply(const MatrixView &image, BorderMode border, float value = 0) const override;
+        Matrix8u apply(const Matrix8u &image) const; // sliding 256-bin histogram, the mean of the two middle values is rounded
+
+    private:
+        int size;
+        float compute_median(const MatrixView &image, int row, int col, int size) const;
+    };
+
+    // Maximum of each size x size window, with the running maximum of van
+    // Herk and Gil-Werman along rows and then columns: about six comparisons
+    // per pixel whatever the size, instead of size^2.
+    class MaxFilter : public Filter
+    {
+    public:
+        using Filter::apply;
+        MaxFilter(int size);
+        virtual Matrix apply(const MatrixView &image) const override; // the window shrinks at the border
+        virtual Matrix apply(const MatrixView &image, BorderMode border, float value = 0) const override;
 
     private:
         int size;
-        float compute_median(const Matrix &image, int row, int col, int size) const;
+        Matrix running_max(const Matrix &padded) const; // (rows - size + 1) x (cols - size + 1) full windows
     };
 
     // TODO: add more filters as needed
@@ -1,43 +1,240 @@
 #include "FeatureExtraction/Filter.hpp"
 #include "helpers/Matrix.hpp"
+#include "helpers/Border.hpp"
+#include "helpers/Simd.hpp"
 
 #include <cmath>
 #include <stdexcept>
 #include <algorithm>
+#include <limits>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace VisualAlgo::FeatureExtraction
 {
 
-    GaussianFilter::GaussianFilter(float sigma)
+    std::string to_string(GaussianMethod method)
+    {
+        switch (method)
+        {
+        case GaussianMethod::AUTO:
+            return "auto";
+        case GaussianMethod::KERNEL:
+            return "kernel";
+        case GaussianMethod::RECURSIVE:
+            return "recursive";
+        default:
+            return "unknown";
+        }
+    }
+
+    namespace
+    {
+        // Rows of the image transposed at a time for the row pass of the
+        // recursive Gaussian, the strip stays in cache
+        constexpr int RECURSIVE_STRIP_ROWS = 64;
+
+        // Recursive Gaussian of Young, van Vliet and van Ginkel (2002),
+        // w[n] = B x[n] + a1 w[n - 1] + a2 w[n - 2] + a3 w[n - 3], run forward
+        // and then backward. B = 1 - a1 - a2 - a3, so a flat signal stays flat.
+        struct RecursiveGaussian
+        {
+            double B, a1, a2, a3;
+            double M[9]; // Triggs and Sdika (2006) end condition of the backward pass
+
+            explicit RecursiveGaussian(float sigma)
+            {
+                const double m0 = 1.16680, m1 = 1.10783, m2 = 1.40586;
+                double q = sigma < 3.556 ? -0.2568 + 0.5784 * sigma + 0.0561 * sigma * sigma : 2.5091 + 0.9804 * (sigma - 3.556);
+                double scale = (m0 + q) * (m1 * m1 + m2 * m2 + 2 * m1 * q + q * q);
+                a1 = q * (2 * m0 * m1 + m1 * m1 + m2 * m2 + (2 * m0 + 4 * m1) * q + 3 * q * q) / scale;
+                a2 = -q * q * (m0 + 2 * m1 + 3 * q) / scale;
+                a3 = q * q * q / scale;
+                B = 1 - a1 - a2 - a3;
+
+                double norm = 1 / ((1 + a1 - a2 + a3) * (1 - a1 - a2 - a3) * (1 + a2 + (a1 - a3) * a3));
+                M[0] = norm * (-a3 * a1 + 1 - a3 * a3 - a2);
+                M[1] = norm * (a3 + a1) * (a2 + a3 * a1);
+                M[2] = norm * a3 * (a1 + a3 * a2);
+                M[3] = norm * (a1 + a3 * a2);
+                M[4] = -norm * (a2 - 1) * (a2 + a3 * a1);
+                M[5] = -norm * a3 * (a3 * a1 + a3 * a3 + a2 - 1);
+                M[6] = norm * (a3 * a1 + a2 + a1 * a1 - a2 * a2);
+                M[7] = norm * (a1 * a2 + a3 * a2 * a2 - a1 * a3 * a3 - a3 * a3 * a3 - a3 * a2 + a3);
+                M[8] = norm * a3 * (a1 + a3 * a2);
+            }
+
+            // Filters every column of a row-major rows x cols buffer, a whole
+            // row at a time so that the inner loops are contiguous. The signal
+            // is taken as constant beyond both ends: the edge rows, or
+            // `constant` when it is given.
+            void filter_columns(double *data, int rows, int cols, std::optional<double> constant = std::nullopt) const
+            {
+                auto row = [&](int i)
+                {
+                    return data + static_cast<size_t>(i) * cols;
+                };
+                std::vector<double> first, last;
+                if (constant)
+                {
+                    first.assign(cols, *constant);
+                    last.assign(cols, *constant);
+                }
+                else
+                {
+                    first.assign(row(0), row(0) + cols);
+                    last.assign(row(rows - 1), row(rows - 1) + cols);
+                }
+
+                // Forward, from the steady state of what precedes the first row
+                const double *w1 = first.data(), *w2 = first.data(), *w3 = first.data();
+                for (int i = 0; i < rows; i++)
+                {
+                    double *w = row(i);
+                    for (int j = 0; j < cols; j++)
+                        w[j] = B * w[j] + a1 * w1[j] + a2 * w2[j] + a3 * w3[j];
+                    w3 = w2;
+                    w2 = w1;
+                    w1 = w;
+                }
+
+                // Backward, the last row and the two after it follow from the
+                // last three forward outputs
+                std::vector<double> after(2 * static_cast<size_t>(cols));
+                double *y = row(rows - 1), *y1 = after.data(), *y2 = after.data() + cols;
+                const double *u1 = rows > 1 ? row(rows - 2) : row(rows - 1), *u2 = rows > 2 ? row(rows - 3) : u1;
+                for (int j = 0; j < cols; j++)
+                {
+                    double d0 = y[j] - last[j], d1 = u1[j] - last[j], d2 = u2[j] - last[j];
+                    y[j] = last[j] + B * (M[0] * d0 + M[1] * d1 + M[2] * d2);
+                    y1[j] = last[j] + B * (M[3] * d0 + M[4] * d1 + M[5] * d2);
+                    y2[j] = last[j] + B * (M[6] * d0 + M[7] * d1 + M[8] * d2);
+                }
+                const double *v1 = y, *v2 = y1, *v3 = y2;
+                for (int i = rows - 2; i >= 0; i--)
+                {
+                    double *v = row(i);
+                    for (int j = 0; j < cols; j++)
+                        v[j] = B * v[j] + a1 * v1[j] + a2 * v2[j] + a3 * v3[j];
+                    v3 = v2;
+                    v2 = v1;
+                    v1 = v;
+                }
+            }
+        };
+    }
+
+    GaussianFilter::GaussianFilter(float sigma, GaussianMethod method)
     {
         if (sigma <= 0)
             throw std::invalid_argument("Sigma must be positive");
+        if (method == GaussianMethod::RECURSIVE && sigma < 1)
+            throw std::invalid_argument("The recursive Gaussian needs a sigma of at least 1");
         this->sigma = sigma;
-        this->kernel = computeGaussianKernel(sigma);
+        if (method == GaussianMethod::AUTO)
+            method = sigma >= RECURSIVE_GAUSSIAN_MIN_SIGMA ? GaussianMethod::RECURSIVE : GaussianMethod::KERNEL;
+        this->method = method;
+        // The recursive filter needs no kernel, its cost stays independent of sigma
+        if (method == GaussianMethod::RECURSIVE)
+            return;
+        // Sampled once per sigma, scale spaces build the same filters over and over
+        this->kernel_1d = KernelCache::global().get("gaussian_1d", {sigma}, [this, sigma]
+                                                    { return computeGaussianKernel1D(sigma); });
+    }
+
+    Matrix GaussianFilter::apply(const MatrixView &image) const
+    {
+        return this->apply(image, BorderMode::REFLECT_101);
     }
 
-    Matrix GaussianFilter::apply(const Matrix &image) const
+    Matrix GaussianFilter::apply(const MatrixView &image, BorderMode border, float value) const
     {
-        return image.convolve(kernel);
+        if (this->method == GaussianMethod::RECURSIVE)
+            return applyRecursive(image, border, value);
+        return image.convolve_separable(*kernel_1d, *kernel_1d, border, value);
     }
 
-    Matrix GaussianFilter::computeGaussianKernel(float sigma) const
+    GaussianMethod GaussianFilter::applied_method() const
+    {
+        return this->method;
+    }
+
+    const Matrix &GaussianFilter::taps() const
+    {
+        if (!this->kernel_1d)
+            throw std::invalid_argument("The recursive Gaussian has no kernel");
+        return *this->kernel_1d;
+    }
+
+    Matrix GaussianFilter::applyRecursive(const MatrixView &image, BorderMode border, float value) const
+    {
+        Matrix result(image.rows, image.cols);
+        if (image.rows == 0 || image.cols == 0)
+            return result;
+
+        // The end conditions of the filter already extend the image with a
+        // constant: its edge rows and columns for REPLICATE, the value for
+        // CONSTANT. The other modes are extended explicitly as far as the
+        // kernel would reach, even past the image size: beyond the margin the
+        // end condition continues the outermost value, not the reflection.
+        int margin = 0;
+        std::optional<double> constant;
+        if (border == BorderMode::CONSTANT)
+            constant = value;
+        else if (border != BorderMode::REPLICATE)
+            margin = ceil(3 * sigma);
+        const int rows = image.rows + 2 * margin, cols = image.cols + 2 * margin;
+        const RecursiveGaussian g(this->sigma);
+
+        std::vector<int> source_cols(cols);
+        for (int j = 0; j < cols; j++)
+            source_cols[j] = border_index(j - margin, image.cols, border);
+        std::vector<double> data(static_cast<size_t>(rows) * cols);
+        for (int i = 0; i < rows; i++)
+        {
+            const float *in = image[border_index(i - margin, image.rows, border)];
+            double *out = data.data() + static_cast<size_t>(i) * cols;
+            for (int j = 0; j < cols; j++)
+                out[j] = in[source_cols[j]];
+        }
+        g.filter_columns(data.data(), rows, cols, constant);
+
+        // Rows of the image only, as the columns of transposed strips of rows
+        const int strip = std::min(RECURSIVE_STRIP_ROWS, image.rows);
+        std::vector<double> transposed(static_cast<size_t>(cols) * strip);
+        for (int first = 0; first < image.rows; first += strip)
+        {
+            const int n = std::min(strip, image.rows - first);
+            for (int i = 0; i < n; i++)
+            {
+                const double *in = data.data() + static_cast<size_t>(first + margin + i) * cols;
+                for (int j = 0; j < cols; j++)
+                    transposed[static_cast<size_t>(j) * n + i] = in[j];
+            }
+            g.filter_columns(transposed.data(), cols, n, constant);
+            for (int i = 0; i < n; i++)
+            {
+                float *out = result[first + i];
+                for (int j = 0; j < image.cols; j++)
+                    out[j] = static_cast<float>(transposed[static_cast<size_t>(j + margin) * n + i]);
+            }
+        }
+        return result;
+    }
+
+    Matrix GaussianFilter::computeGaussianKernel1D(float sigma) const
     {
         int size = 2 * ceil(3 * sigma) + 1;
-        Matrix kernel(size, size);
+        Matrix kernel(1, size);
 
         float sum = 0.0f;
         for (int i = 0; i < size; i++)
         {
             int x = i - size / 2;
-            for (int j = 0; j < size; j++)
-            {
-                int y = j - size / 2;
-                float value = exp(-(x * x + y * y) / (2 * sigma * sigma));
-                kernel.set(i, j, value);
-                sum += value;
-            }
+            float value = exp(-(x * x) / (2 * sigma * sigma));
+            kernel.set(0, i, value);
+            sum += value;
         }
 
         return kernel / sum;
@@ -50,9 +247,14 @@ namespace VisualAlgo::FeatureExtraction
                                {1, 0, -1}});
     }
 
-    Matrix SobelFilterX::apply(const Matrix &image) const
+    Matrix SobelFilterX::apply(const MatrixView &image) const
     {
-        return image.convolve(kernel);
+        return this->apply(image, BorderMode::REFLECT_101);
+    }
+
+    Matrix SobelFilterX::apply(const MatrixView &image, BorderMode border, float value) const
+    {
+        return image.convolve(kernel, border, value);
     }
 
     SobelFilterY::SobelFilterY()
@@ -62,20 +264,31 @@ namespace VisualAlgo::FeatureExtraction
                                {-1, -2, -1}});
     }
 
-    Matrix SobelFilterY::apply(const Matrix &image) const
+    Matrix SobelFilterY::apply(const MatrixView &image) const
     {
-        return image.convolve(kernel);
+        return this->apply(image, BorderMode::REFLECT_101);
+    }
+
+    Matrix SobelFilterY::apply(const MatrixView &image, BorderMode border, float value) const
+    {
+        return image.convolve(kernel, border, value);
     }
 
     LoGFilter::LoGFilter(float sigma)
     {
         this->sigma = sigma;
-        this->kernel = computeLoGKernel(sigma);
+        this->shared_kernel = KernelCache::global().get("log", {sigma}, [this, sigma]
+                                                        { return computeLoGKernel(sigma); });
+    }
+
+    Matrix LoGFilter::apply(const MatrixView &image) const
+    {
+        return this->apply(image, BorderMode::REFLECT_101);
     }
 
-    Matrix LoGFilter::apply(const Matrix &image) const
+    Matrix LoGFilter::apply(const MatrixView &image, BorderMode border, float value) const
     {
-        return image.convolve(kernel);
+        return image.convolve(*shared_kernel, border, value);
     }
 
     Matrix LoGFilter::computeLoGKernel(float sigma) const
@@ -107,9 +320,9 @@ namespace VisualAlgo::FeatureExtraction
             throw std::invalid_argument("Size must be odd");
     }
 
-    Matrix MedianFilter::apply(const Matrix &image) const
+    Matrix MedianFilter::apply(const MatrixView &image) const
     {
-        Matrix result = image;
+        Matrix result(image.rows, image.cols);
 
         for (int i = 0; i < image.rows; ++i)
         {
@@ -122,7 +335,81 @@ namespace VisualAlgo::FeatureExtraction
         return result;
     }
 
-    float MedianFilter::compute_median(const Matrix &image, int row, int col, int size) const
+    Matrix MedianFilter::apply(const MatrixView &image, BorderMode border, float value) const
+    {
+        // Every window is full in the padded image
+        const int radius = size / 2;
+        Matrix padded = image.pad(radius, radius, radius, radius, border, value);
+        Matrix result(image.rows, image.cols);
+        std::vector<float> neighborhood(size * size);
+
+        for (int i = 0; i < image.rows; ++i)
+        {
+            for (int j = 0; j < image.cols; ++j)
+            {
+                for (int p = 0; p < size; ++p)
+                    std::copy(padded[i + p] + j, padded[i + p] + j + size, neighborhood.begin() + p * size);
+                std::nth_element(neighborhood.begin(), neighborhood.begin() + neighborhood.size() / 2, neighborhood.end());
+                result[i][j] = neighborhood[neighborhood.size() / 2];
+            }
+        }
+
+        return result;
+    }
+
+    Matrix8u MedianFilter::apply(const Matrix8u &image) const
+    {
+        Matrix8u result(image.rows, image.cols);
+        const int radius = size / 2;
+
+        // Slide a histogram of the window along each row: moving one column
+        // right removes a column of pixels and adds one, instead of sorting
+        // the whole window again.
+        for (int i = 0; i < image.rows; ++i)
+        {
+            const int row_start = std::max(0, i - radius);
+            const int row_end = std::min(image.rows - 1, i + radius);
+            int histogram[256] = {};
+            int count = 0;
+
+            auto add_column = [&](int col, int delta)
+            {
+                if (col < 0 || col >= image.cols)
+                    return;
+                for (int r = row_start; r <= row_end; ++r)
+                    histogram[image[r][col]] += delta;
+                count += delta * (row_end - row_start + 1);
+            };
+
+            for (int j = -radius; j < radius; ++j)
+                add_column(j, 1);
+
+            uint8_t *out = result[i];
+            for (int j = 0; j < image.cols; ++j)
+            {
+                add_column(j + radius, 1);
+
+                // Values of rank (count - 1) / 2 and count / 2, equal when count is odd
+                const int low_rank = (count - 1) / 2, high_rank = count / 2;
+                int low = -1, high = -1, seen = 0;
+                for (int value = 0; value < 256 && high < 0; ++value)
+                {
+                    seen += histogram[value];
+                    if (low < 0 && seen > low_rank)
+                        low = value;
+                    if (seen > high_rank)
+                        high = value;
+                }
+                out[j] = (low + high + 1) / 2;
+
+                add_column(j - radius, -1);
+            }
+        }
+
+        return result;
+    }
+
+    float MedianFilter::compute_median(const MatrixView &image, int row, int col, int size) const
     {
         std::vector<float> neighborhood;
 
@@ -147,4 +434,72 @@ namespace VisualAlgo::FeatureExtraction
         return neighborhood[neighborhood.size() / 2];
     }
 
+    MaxFilter::MaxFilter(int size) : size(size)
+    {
+        if (size <= 0)
+            throw std::invalid_argument("Size must be positive");
+        if (size % 2 == 0)
+            throw std::invalid_argument("Size must be odd");
+    }
+
+    Matrix MaxFilter::apply(const MatrixView &image) const
+    {
+        // Padding with -infinity never wins, which shrinks the window
+        const int radius = size / 2;
+        return running_max(image.pad(radius, radius, radius, radius, BorderMode::CONSTANT, -std::numeric_limits<float>::infinity()));
+    }
+
+    Matrix MaxFilter::apply(const MatrixView &image, BorderMode border, float value) const
+    {
+        const int radius = size / 2;
+        return running_max(image.pad(radius, radius, radius, radius, border, value));
+    }
+
+    Matrix MaxFilter::running_max(const Matrix &padded) const
+    {
+        // The values are split into blocks of `size`, each with its prefix
+        // and suffix maxima. A window of `size` values covers the suffix of
+        // one block and the prefix of the next, so its maximum is the larger
+        // of the two.
+        const int rows = padded.rows - size + 1;
+        const int cols = padded.cols - size + 1;
+
+        Matrix horizontal(padded.rows, cols);
+        std::vector<float> prefix(padded.cols), suffix(padded.cols);
+        for (int i = 0; i < padded.rows; i++)
+        {
+            const float *in = padded[i];
+            for (int start = 0; start < padded.cols; start += size)
+            {
+                const int end = std::min(start + size, padded.cols);
+                prefix[start] = in[start];
+                for (int j = start + 1; j < end; j++)
+                    prefix[j] = std::max(prefix[j - 1], in[j]);
+                suffix[end - 1] = in[end - 1];
+                for (int j = end - 2; j >= start; j--)
+                    suffix[j] = std::max(suffix[j + 1], in[j]);
+            }
+            float *out = horizontal[i];
+            for (int j = 0; j < cols; j++)
+                out[j] = std::max(suffix[j], prefix[j + size - 1]);
+        }
+
+        // Along columns a whole row at a time, so that the comparisons are vectorized
+        Matrix prefix_rows(padded.rows, cols), suffix_rows(padded.rows, cols);
+        for (int start = 0; start < padded.rows; start += size)
+        {
+            const int end = std::min(start + size, padded.rows);
+            std::copy(horizontal[start], horizontal[start] + cols, prefix_rows[start]);
+            for (int i = start + 1; i < end; i++)
+                Simd::maximum(prefix_rows[i - 1], horizontal[i], prefix_rows[i], cols);
+            std::copy(horizontal[end - 1], horizontal[end - 1] + cols, suffix_rows[end - 1]);
+            for (int i = end - 2; i >= start; i--)
+                Simd::maximum(suffix_rows[i + 1], horizontal[i], suffix_rows[i], cols);
+        }
+
+        Matrix result(rows, cols);
+        for (int i = 0; i < rows; i++)
+            Simd::maximum(suffix_rows[i], prefix_rows[i + size - 1], result[i], cols);
+        return result;
+    }
 }
\ No newline at end of file
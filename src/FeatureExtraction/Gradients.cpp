@@ -6,13 +6,13 @@
 
 namespace VisualAlgo::FeatureExtraction
 {
-    Matrix Gradients::computeXGradient(const Matrix &image)
+    Matrix Gradients::computeXGradient(const MatrixView &image)
     {
         SobelFilterX filter;
         return filter.apply(image);
     }
 
-    Matrix Gradients::computeYGradient(const Matrix &image)
+    Matrix Gradients::computeYGradient(const MatrixView &image)
     {
         SobelFilterY filter;
         return filter.apply(image);
@@ -33,7 +33,7 @@ namespace VisualAlgo::FeatureExtraction
         return result;
     }
 
-    Matrix Gradients::computeGradientMagnitude(const Matrix &image)
+    Matrix Gradients::computeGradientMagnitude(const MatrixView &image)
     {
         Matrix xGradient = computeXGradient(image);
         Matrix yGradient = computeYGradient(image);
@@ -67,7 +67,7 @@ namespace VisualAlgo::FeatureExtraction
         return result;
     }
 
-    Matrix Gradients::computeGradientDirection(const Matrix &image)
+    Matrix Gradients::computeGradientDirection(const MatrixView &image)
     {
         Matrix xGradient = computeXGradient(image);
         Matrix yGradient = computeYGradient(image);
@@ -5,11 +5,11 @@
 namespace VisualAlgo::FeatureExtraction {
     class Gradients {
     public:
-        static Matrix computeXGradient(const Matrix& image);
-        static Matrix computeYGradient(const Matrix& image);
+        static Matrix computeXGradient(const MatrixView& image);
+        static Matrix computeYGradient(const MatrixView& image);
         static Matrix computeGradientMagnitude(const Matrix& xGradient, const Matrix& yGradient);
-        static Matrix computeGradientMagnitude(const Matrix& image);
+        static Matrix computeGradientMagnitude(const MatrixView& image);
         static Matrix computeGradientDirection(const Matrix& xGradient, const Matrix& yGradient, float threshold = 0.01);
-        static Matrix computeGradientDirection(const Matrix& image);
+        static Matrix computeGradientDirection(const MatrixView& image);
     };
 }
@@ -1,83 +1,308 @@
 #include "Harris.hpp"
 #include "Gradients.hpp"
 #include "Filter.hpp"
+#include "helpers/Border.hpp"
 #include "helpers/Matrix.hpp"
 #include "helpers/ProgressBar.hpp"
+#include "helpers/Simd.hpp"
 
+#include <algorithm>
 #include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace VisualAlgo::FeatureExtraction
 {
+    namespace
+    {
+        void response_row(const float *Gxx, const float *Gyy, const float *Gxy, float k, float *R, int cols)
+        {
+            for (int j = 0; j < cols; ++j)
+            {
+                float det = Gxx[j] * Gyy[j] - Gxy[j] * Gxy[j];
+                float trace = Gxx[j] + Gyy[j];
+                R[j] = det - k * trace * trace;
+            }
+        }
+
+        // The response of whole images: gradients, their products, three
+        // Gaussian filters, for the recursive Gaussian
+        void stream_staged(const MatrixView &image, const GaussianFilter &g, float k, const std::function<void(int, const float *)> &row)
+        {
+            Matrix Ix = Gradients::computeXGradient(image);
+            Matrix Iy = Gradients::computeYGradient(image);
+            Matrix Gxx = g.apply(Ix * Ix);
+            Matrix Gyy = g.apply(Iy * Iy);
+            Matrix Gxy = g.apply(Ix * Iy);
+            std::vector<float> R(image.cols);
+            for (int i = 0; i < image.rows; ++i)
+            {
+                response_row(Gxx[i], Gyy[i], Gxy[i], k, R.data(), image.cols);
+                row(i, R.data());
+            }
+        }
+
+        // The response one row at a time. Each row of the gradient products is
+        // computed, smoothed along the row and kept in a ring of the
+        // 2 * radius + 1 rows that the column pass of the Gaussian needs, so
+        // only a few rows of each temporary are alive (and in cache) at once
+        // instead of nine images. The sums are those of SobelFilterX/Y and
+        // GaussianFilter, in the same order, so the response is the same to
+        // the last bit as filtering whole images.
+        void stream_fused(const MatrixView &image, const GaussianFilter &g, float k, const std::function<void(int, const float *)> &row)
+        {
+            const int rows = image.rows, cols = image.cols;
+            const Matrix &taps = g.taps();
+            const int size = taps.cols, radius = size / 2;
+
+            // Sobel kernels flipped, as the filters convolve
+            static const float sobel_x[9] = {-1, 0, 1, -2, 0, 2, -1, 0, 1};
+            static const float sobel_y[9] = {-1, -2, -1, 0, 0, 0, 1, 2, 1};
+
+            // Source column of every column extended by the Sobel and Gaussian windows
+            std::vector<int> image_cols(cols + 2), product_cols(cols + 2 * radius);
+            for (int j = 0; j < cols + 2; ++j)
+                image_cols[j] = border_index(j - 1, cols, BorderMode::REFLECT_101);
+            for (int j = 0; j < cols + 2 * radius; ++j)
+                product_cols[j] = border_index(j - radius, cols, BorderMode::REFLECT_101);
+
+            Matrix extended(3, cols + 2), gradients(2, cols), products(3, cols), extended_products(3, cols + 2 * radius);
+            std::vector<Matrix> ring(3, Matrix(size, cols)); // xx, yy, xy smoothed along rows
+            Matrix smoothed(3, cols);
+            std::vector<float> R(cols);
+
+            // Row v of the image extended by radius rows, smoothed along the row, into ring slot v % size
+            auto smooth_row = [&](int v)
+            {
+                const int m = border_index(v - radius, rows, BorderMode::REFLECT_101);
+                const float *window[3];
+                for (int p = 0; p < 3; ++p)
+                {
+                    const float *in = image[border_index(m - 1 + p, rows, BorderMode::REFLECT_101)];
+                    float *out = extended[p];
+                    for (int j = 0; j < cols + 2; ++j)
+                        out[j] = in[image_cols[j]];
+                    window[p] = out;
+                }
+                float *Ix = gradients[0], *Iy = gradients[1];
+                std::fill(Ix, Ix + cols, 0.0f);
+                std::fill(Iy, Iy + cols, 0.0f);
+                Simd::correlate_square(window, sobel_x, 3, Ix, cols);
+                Simd::correlate_square(window, sobel_y, 3, Iy, cols);
+                Simd::mul(Ix, Ix, products[0], cols);
+                Simd::mul(Iy, Iy, products[1], cols);
+                Simd::mul(Ix, Iy, products[2], cols);
+
+                for (int n = 0; n < 3; ++n)
+                {
+                    const float *in = products[n];
+                    float *out = extended_products[n];
+                    for (int j = 0; j < cols + 2 * radius; ++j)
+                        out[j] = in[product_cols[j]];
+                    float *slot = ring[n][v % size];
+                    std::fill(slot, slot + cols, 0.0f);
+                    Simd::correlate_row(out, taps[0], size, slot, cols);
+                }
+            };
+
+            for (int v = 0; v < size - 1; ++v)
+                smooth_row(v);
+            for (int i = 0; i < rows; ++i)
+            {
+                smooth_row(i + size - 1);
+                for (int n = 0; n < 3; ++n)
+                {
+                    float *out = smoothed[n];
+                    std::fill(out, out + cols, 0.0f);
+                    for (int p = 0; p < size; ++p)
+                        Simd::correlate_row(ring[n][(i + p) % size], taps[0] + p, 1, out, cols);
+                }
+                response_row(smoothed[0], smoothed[1], smoothed[2], k, R.data(), cols);
+                row(i, R.data());
+            }
+        }
+
+        void check_selection(const CornerSelection &selection)
+        {
+            if (selection.window_size < 1 || selection.window_size % 2 == 0)
+                throw std::invalid_argument("Window size must be odd and positive. Got " + std::to_string(selection.window_size) + " instead.");
+            if (selection.cell_size < 0)
+                throw std::invalid_argument("Cell size must be non-negative. Got " + std::to_string(selection.cell_size) + " instead.");
+            if (selection.max_per_cell < 1)
+                throw std::invalid_argument("Max corners per cell must be positive. Got " + std::to_string(selection.max_per_cell) + " instead.");
+            if (selection.max_corners < 0)
+                throw std::invalid_argument("Max corners must be non-negative. Got " + std::to_string(selection.max_corners) + " instead.");
+        }
+
+        typedef std::tuple<int, int, float> Corner; // (row, col, response)
+
+        // Strongest first, ties by position so that the order never depends on the input order
+        bool stronger(const Corner &a, const Corner &b)
+        {
+            if (std::get<2>(a) != std::get<2>(b))
+                return std::get<2>(a) > std::get<2>(b);
+            return std::make_pair(std::get<0>(a), std::get<1>(a)) < std::make_pair(std::get<0>(b), std::get<1>(b));
+        }
+
+        // Keeps the `capacity` strongest corners offered (all of them for 0),
+        // in a heap with the weakest one on top
+        class BoundedHeap
+        {
+        public:
+            explicit BoundedHeap(int capacity = 0) : capacity(capacity) {}
+
+            void offer(const Corner &corner)
+            {
+                if (this->capacity == 0)
+                {
+                    this->corners.push_back(corner);
+                    return;
+                }
+                if ((int)this->corners.size() < this->capacity)
+                {
+                    this->corners.push_back(corner);
+                    std::push_heap(this->corners.begin(), this->corners.end(), stronger);
+                    return;
+                }
+                if (!stronger(corner, this->corners.front()))
+                    return;
+                std::pop_heap(this->corners.begin(), this->corners.end(), stronger);
+                this->corners.back() = corner;
+                std::push_heap(this->corners.begin(), this->corners.end(), stronger);
+            }
+
+            std::vector<Corner> corners;
+
+        private:
+            int capacity;
+        };
 
-    Harris::Harris(float sigma, float k, float threshold)
-        : sigma(sigma), k(k), threshold(threshold)
+        void stream_response(const MatrixView &image, float sigma, float k, const std::function<void(int, const float *)> &row)
+        {
+            if (sigma <= 0)
+                throw std::invalid_argument("Sigma must be positive");
+            if (image.rows == 0 || image.cols == 0)
+                return;
+            GaussianFilter g(sigma, GaussianMethod::AUTO);
+            if (g.applied_method() == GaussianMethod::RECURSIVE)
+                stream_staged(image, g, k, row);
+            else
+                stream_fused(image, g, k, row);
+        }
+    }
+
+    Harris::Harris(float sigma, float k, float threshold, CornerSelection selection)
+        : sigma(sigma), k(k), threshold(threshold), selection(selection)
     {
         if (sigma <= 0)
             throw std::invalid_argument("Sigma must be positive");
 
         if (k <= 0)
             throw std::invalid_argument("K must be positive");
+
+        check_selection(selection);
     }
 
-    Matrix Harris::apply(const Matrix &image) const
+    Matrix Harris::apply(const MatrixView &image) const
     {
         Matrix result(image.rows, image.cols);
-        auto corners = detect(image, sigma, k, threshold);
+        auto corners = detect_strongest(image, sigma, k, threshold, selection);
         for (auto corner : corners)
         {
-            result.set(corner.first, corner.second, 1);
+            result.set(std::get<0>(corner), std::get<1>(corner), 1);
         }
         return result;
     }
 
-    std::vector<std::pair<int, int>> Harris::detect(const Matrix &image, float sigma, float k, float threshold)
+    std::vector<std::pair<int, int>> Harris::detect(const MatrixView &image, float sigma, float k, float threshold)
     {
-        ProgressBar progress_bar(5, "Harris corner detection");
-        // Step 1: Compute gradients
-        progress_bar.step("Computing gradients...");
-        Matrix Ix = Gradients::computeXGradient(image);
-        Matrix Iy = Gradients::computeYGradient(image);
-
-        // Step 2: Compute (element-wise) products of gradients
-        progress_bar.step("Computing products of gradients...");
-        Matrix Ixx = Ix * Ix;
-        Matrix Iyy = Iy * Iy;
-        Matrix Ixy = Ix * Iy;
-
-        // Step 3: Apply Gaussian filter
-        progress_bar.step("Applying Gaussian filter...");
-        GaussianFilter g(sigma);
-        Matrix Gxx = g.apply(Ixx);
-        Matrix Gyy = g.apply(Iyy);
-        Matrix Gxy = g.apply(Ixy);
-
-        // Step 4: Calculate corner response function (R)
-        progress_bar.step("Calculating corner response function...");
-        Matrix R(image.rows, image.cols);
-        for (int i = 0; i < image.rows; ++i)
-        {
+        ProgressBar progress_bar(1, "Harris corner detection");
+        progress_bar.step("Computing and thresholding the corner response...");
+        std::vector<std::pair<int, int>> corners;
+        detect(image, sigma, k, threshold, [&](int i, int j, float)
+               { corners.push_back({i, j}); });
+        return corners;
+    }
+
+    void Harris::detect(const MatrixView &image, float sigma, float k, float threshold, const std::function<void(int, int, float)> &corner)
+    {
+        stream_response(image, sigma, k, [&](int i, const float *R)
+                        {
             for (int j = 0; j < image.cols; ++j)
             {
-                float det = Gxx.get(i, j) * Gyy.get(i, j) - Gxy.get(i, j) * Gxy.get(i, j);
-                float trace = Gxx.get(i, j) + Gyy.get(i, j);
-                R.set(i, j, det - k * trace * trace);
-            }
-        }
+                if (R[j] > threshold)
+                    corner(i, j, R[j]);
+            } });
+    }
 
-        // Step 5: Threshold the corner response function
-        progress_bar.step("Thresholding...");
-        std::vector<std::pair<int, int>> corners;
-        for (int i = 0; i < R.rows; ++i)
+    std::vector<std::tuple<int, int, float>> Harris::detect_strongest(const MatrixView &image, float sigma, float k, float threshold, const CornerSelection &selection)
+    {
+        check_selection(selection);
+        const int rows = image.rows, cols = image.cols;
+        const int window = selection.window_size, half = window / 2;
+
+        // One bounded heap per cell, or a single one for the whole image
+        const int cell = selection.cell_size > 0 ? selection.cell_size : std::max(1, std::max(rows, cols));
+        const int cells_per_row = (cols + cell - 1) / cell;
+        std::vector<BoundedHeap> heaps((rows + cell - 1) / cell * cells_per_row,
+                                       BoundedHeap(selection.cell_size > 0 ? selection.max_per_cell : selection.max_corners));
+
+        // The last `window` rows of the response and their maxima over
+        // `window` columns. Row i is decided once row i + half has arrived: a
+        // corner must not be below any pixel of its window.
+        Matrix ring(window, cols), row_maxima(window, cols);
+        auto decide = [&](int i)
         {
-            for (int j = 0; j < R.cols; ++j)
+            const float *R = ring[i % window];
+            const int first = std::max(0, i - half), last = std::min(rows - 1, i + half);
+            for (int j = 0; j < cols; ++j)
             {
-                if (R.get(i, j) > threshold)
-                {
-                    corners.push_back({i, j});
-                }
+                const float response = R[j];
+                if (!(response > threshold))
+                    continue;
+                bool is_maximum = true;
+                for (int r = first; r <= last && is_maximum; ++r)
+                    is_maximum = !(row_maxima[r % window][j] > response);
+                if (is_maximum)
+                    heaps[i / cell * cells_per_row + j / cell].offer({i, j, response});
             }
+        };
+
+        stream_response(image, sigma, k, [&](int m, const float *R)
+                        {
+            std::copy(R, R + cols, ring[m % window]);
+            float *maxima = row_maxima[m % window];
+            std::copy(R, R + cols, maxima);
+            for (int d = 1; d <= half && d < cols; ++d)
+            {
+                Simd::maximum(maxima, R + d, maxima, cols - d);
+                Simd::maximum(maxima + d, R, maxima + d, cols - d);
+            }
+            if (m - half >= 0)
+                decide(m - half); });
+        for (int i = std::max(0, rows - half); i < rows; ++i)
+            decide(i);
+
+        std::vector<std::tuple<int, int, float>> corners;
+        for (const BoundedHeap &heap : heaps)
+            corners.insert(corners.end(), heap.corners.begin(), heap.corners.end());
+        if (selection.max_corners > 0 && (int)corners.size() > selection.max_corners)
+        {
+            std::nth_element(corners.begin(), corners.begin() + selection.max_corners, corners.end(), stronger);
+            corners.resize(selection.max_corners);
         }
+        std::sort(corners.begin(), corners.end(), stronger);
         return corners;
     }
 
+    Matrix Harris::response(const MatrixView &image, float sigma, float k)
+    {
+        Matrix R(image.rows, image.cols);
+        stream_response(image, sigma, k, [&](int i, const float *row)
+                        { std::copy(row, row + image.cols, R[i]); });
+        return R;
+    }
+
 }
@@ -4,18 +4,50 @@
 #include "Gradients.hpp"
 #include "Filter.hpp"
 
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 namespace VisualAlgo::FeatureExtraction
 {
 
+    // Which of the pixels above the threshold Harris::detect_strongest keeps,
+    // applied in this order. The defaults keep them all.
+    struct CornerSelection
+    {
+        int window_size = 1;  // odd, corners must be the maximum of their window_size x window_size window
+        int cell_size = 0;    // the image is split into cell_size x cell_size cells (0 for none)...
+        int max_per_cell = 1; // ... and only the strongest max_per_cell corners of each cell are kept
+        int max_corners = 0;  // the strongest max_corners corners overall (0 for no limit)
+    };
+
     class Harris
     {
     public:
-        Harris(float sigma, float k, float threshold);
+        Harris(float sigma, float k, float threshold, CornerSelection selection = CornerSelection());
+
+        Matrix apply(const MatrixView &image) const;
+        static std::vector<std::pair<int, int>> detect(const MatrixView &image, float sigma, float k, float threshold);
+
+        // Calls corner(row, col, response) for every pixel whose response is
+        // above the threshold, row by row, without storing the response of
+        // the whole image
+        static void detect(const MatrixView &image, float sigma, float k, float threshold, const std::function<void(int, int, float)> &corner);
+
+        // The corner response det(M) - k * trace(M)^2 of every pixel, M being
+        // the products of the Sobel gradients smoothed by a Gaussian of sigma
+        static Matrix response(const MatrixView &image, float sigma, float k);
+
+        // The corners above the threshold that the selection keeps, as (row,
+        // col, response), strongest first (ties by row, then column). The
+        // response is streamed as for detect, with selection.window_size rows
+        // kept for the maximum test and bounded heaps of the strongest corners.
+        static std::vector<std::tuple<int, int, float>> detect_strongest(const MatrixView &image, float sigma, float k, float threshold, const CornerSelection &selection);
 
-        Matrix apply(const Matrix &image) const;
-        static std::vector<std::pair<int, int>> detect(const Matrix &image, float sigma, float k, float threshold);
     private:
         float sigma, k, threshold;
+        CornerSelection selection;
     };
 
 }
@@ -0,0 +1,203 @@
+#include "ScaleSpace.hpp"
+#include "Filter.hpp"
+#include "helpers/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace VisualAlgo::FeatureExtraction
+{
+    namespace
+    {
+        // Rows blurred by one task
+        constexpr int BLUR_BAND_ROWS = 128;
+
+        // Adds blur to an image blurred with `from` so that it is blurred with
+        // `to`, both in image pixels, at 1 / factor of the image resolution.
+        // With the sampled kernel, each band of rows is blurred on the pool
+        // from the rows the kernel reaches around it, which gives exactly the
+        // same values as blurring the image whole. The recursive filter
+        // reaches every row, it blurs the image whole.
+        Matrix blur(const MatrixView &matrix, float from, float to, int factor)
+        {
+            if (to <= from)
+                return matrix.to_matrix();
+            GaussianFilter g(std::sqrt(to * to - from * from) / factor, GaussianMethod::AUTO);
+            const int bands = (matrix.rows + BLUR_BAND_ROWS - 1) / BLUR_BAND_ROWS;
+            if (g.applied_method() == GaussianMethod::RECURSIVE || bands < 2)
+                return g.apply(matrix);
+
+            const int reach = g.taps().cols / 2;
+            Matrix result(matrix.rows, matrix.cols);
+            ThreadPool::global().parallel_for(bands, [&](int band)
+                                              {
+                const int first = band * BLUR_BAND_ROWS, last = std::min(first + BLUR_BAND_ROWS, matrix.rows);
+                const int top = std::max(0, first - reach), bottom = std::min(matrix.rows, last + reach);
+                Matrix blurred = g.apply(matrix.submatrix(top, bottom, 0, matrix.cols));
+                for (int i = first; i < last; i++)
+                    std::copy(blurred[i - top], blurred[i - top] + matrix.cols, result[i]); });
+            return result;
+        }
+
+        // Keeps every other row and column, the image is already blurred enough
+        Matrix decimate(const Matrix &matrix)
+        {
+            Matrix result((matrix.rows + 1) / 2, (matrix.cols + 1) / 2);
+            for (int i = 0; i < result.rows; i++)
+            {
+                const float *in = matrix[2 * i];
+                float *out = result[i];
+                for (int j = 0; j < result.cols; j++)
+                    out[j] = in[2 * j];
+            }
+            return result;
+        }
+    }
+
+    ScaleSpace::ScaleSpace(const MatrixView &image, std::vector<float> sigmas, bool downsample) : image(image), sigmas(std::move(sigmas))
+    {
+        if (image.rows == 0 || image.cols == 0)
+            throw std::invalid_argument("Image cannot be empty.");
+        for (float sigma : this->sigmas)
+        {
+            if (!(sigma > 0))
+                throw std::invalid_argument("Sigmas must be positive. Got " + std::to_string(sigma) + " instead.");
+            int factor = 1;
+            while (downsample && sigma / (2 * factor) >= SCALE_SPACE_MIN_SIGMA &&
+                   (image.rows + 2 * factor - 1) / (2 * factor) >= SCALE_SPACE_MIN_SIZE &&
+                   (image.cols + 2 * factor - 1) / (2 * factor) >= SCALE_SPACE_MIN_SIZE)
+                factor *= 2;
+            this->factors.push_back(factor);
+        }
+    }
+
+    int ScaleSpace::size() const
+    {
+        return this->sigmas.size();
+    }
+
+    float ScaleSpace::sigma(int level) const
+    {
+        check_level(level);
+        return this->sigmas[level];
+    }
+
+    int ScaleSpace::factor(int level) const
+    {
+        check_level(level);
+        return this->factors[level];
+    }
+
+    const Matrix &ScaleSpace::gaussian(int level)
+    {
+        return gaussian(level, factor(level));
+    }
+
+    const Matrix &ScaleSpace::gaussian(int level, int factor)
+    {
+        check_level(level);
+        if (factor < 1 || (factor & (factor - 1)) != 0 || factor > this->factors[level])
+            throw std::invalid_argument("Factor must be a power of two up to " + std::to_string(this->factors[level]) + ". Got " + std::to_string(factor) + " instead.");
+        Level *entry;
+        {
+            std::lock_guard<std::mutex> lock(this->levels_mutex);
+            std::unique_ptr<Level> &slot = this->levels[{level, factor}];
+            if (!slot)
+                slot = std::make_unique<Level>();
+            entry = slot.get();
+        }
+
+        // Other threads asking for the level meanwhile wait for this blur.
+        // Levels are only blurred from smaller sigmas, so the waits never form a cycle.
+        std::call_once(entry->blurred, [&]()
+                       {
+            const int previous = previous_level(level, factor);
+            if (previous < 0)
+                entry->gaussian = blur(octave(factor), octave_sigma(factor), this->sigmas[level], factor);
+            else
+                entry->gaussian = blur(gaussian(previous, factor), this->sigmas[previous], this->sigmas[level], factor); });
+        return entry->gaussian;
+    }
+
+    Matrix ScaleSpace::dog(int level)
+    {
+        const int factor = dog_factor(level);
+        const Matrix &lower = gaussian(level, factor);
+        const Matrix &upper = gaussian(level + 1, factor);
+        return upper - lower;
+    }
+
+    int ScaleSpace::dog_factor(int level) const
+    {
+        check_level(level);
+        check_level(level + 1);
+        return std::min(this->factors[level], this->factors[level + 1]);
+    }
+
+    Matrix ScaleSpace::laplacian(int level)
+    {
+        // Five-point stencil, scaled from pixels of the level to pixels of the image
+        const int factor = this->factor(level);
+        Matrix stencil({{0, 1, 0},
+                        {1, -4, 1},
+                        {0, 1, 0}});
+        return gaussian(level).cross_correlate(stencil / static_cast<float>(factor * factor));
+    }
+
+    MatrixView ScaleSpace::octave(int factor)
+    {
+        if (factor == 1)
+            return this->image;
+        std::lock_guard<std::mutex> lock(this->octaves_mutex);
+        auto found = this->octaves.find(factor);
+        if (found != this->octaves.end())
+            return found->second;
+
+        // Blurred with SCALE_SPACE_MIN_SIGMA pixels of the halved image from
+        // the previous octave, then halved
+        int f = 1;
+        MatrixView previous = this->image;
+        for (auto &[octave_factor, matrix] : this->octaves)
+        {
+            if (octave_factor < factor)
+            {
+                f = octave_factor;
+                previous = matrix;
+            }
+        }
+        for (; f < factor; f *= 2)
+            previous = this->octaves.emplace(2 * f, decimate(blur(previous, octave_sigma(f), octave_sigma(2 * f), f))).first->second;
+        return previous;
+    }
+
+    int ScaleSpace::previous_level(int level, int factor) const
+    {
+        // The level with the largest sigma below this one that can be stored
+        // at the factor and is blurred more than the octave; equal sigmas are
+        // ordered by level
+        int previous = -1;
+        for (int other = 0; other < size(); other++)
+        {
+            const std::pair<float, int> key(this->sigmas[other], other);
+            if (key < std::make_pair(this->sigmas[level], level) && this->factors[other] >= factor &&
+                this->sigmas[other] > octave_sigma(factor) &&
+                (previous < 0 || key > std::make_pair(this->sigmas[previous], previous)))
+                previous = other;
+        }
+        return previous;
+    }
+
+    float ScaleSpace::octave_sigma(int factor)
+    {
+        return factor == 1 ? 0 : SCALE_SPACE_MIN_SIGMA * factor;
+    }
+
+    void ScaleSpace::check_level(int level) const
+    {
+        if (level < 0 || level >= size())
+            throw std::out_of_range("Level " + std::to_string(level) + " is out of range for a scale space of " + std::to_string(size()) + " levels.");
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "helpers/Matrix.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace VisualAlgo::FeatureExtraction
+{
+    // Below this blur, in pixels of the stored resolution, a level is not
+    // downsampled any further (the base blur of a SIFT octave)
+    constexpr float SCALE_SPACE_MIN_SIGMA = 1.6f;
+
+    // Levels are not downsampled below this many rows or columns
+    constexpr int SCALE_SPACE_MIN_SIZE = 16;
+
+    // Gaussian scale space of an image, built on demand. Every level is
+    // stored at 1 / factor of the image resolution, the factor being the
+    // largest power of two that keeps the blur at SCALE_SPACE_MIN_SIGMA
+    // pixels or more, as in the octaves of SIFT. Each octave is blurred from
+    // the previous one with the difference of the two sigmas (sigma^2 =
+    // sigma_a^2 + sigma_b^2) and halved by dropping every other row and
+    // column, never from the original image again. Within an octave each
+    // level is blurred from the level with the next smaller sigma, or from
+    // the octave for the smallest one, so the result does not depend on the
+    // order the levels are requested in. Levels may be read from several
+    // threads; each one is blurred once, by bands of rows on
+    // ThreadPool::global(). Pixel (i, j) of a level covers pixel
+    // (i * factor, j * factor) of the image.
+    class ScaleSpace
+    {
+    public:
+        // Sigmas in pixels of the image, in any order. downsample = false
+        // keeps every level at full resolution. The image is not copied, it
+        // must outlive the scale space.
+        ScaleSpace(const MatrixView &image, std::vector<float> sigmas, bool downsample = true);
+        ScaleSpace(Matrix &&image, std::vector<float> sigmas, bool downsample = true) = delete;
+
+        int size() const;
+        float sigma(int level) const;
+        int factor(int level) const;
+
+        // Gaussian at the factor of the level, or at a finer power-of-two factor
+        const Matrix &gaussian(int level);
+        const Matrix &gaussian(int level, int factor);
+
+        // gaussian(level + 1) - gaussian(level), at dog_factor(level), the finer factor of the two
+        Matrix dog(int level);
+        int dog_factor(int level) const;
+
+        // Laplacian of gaussian(level) in units of image pixels, i.e. the
+        // Laplacian of Gaussian of the image, at factor(level)
+        Matrix laplacian(int level);
+
+    private:
+        MatrixView image;
+        std::vector<float> sigmas;
+        std::vector<int> factors;
+        std::map<int, Matrix> octaves; // factor -> image blurred with octave_sigma(factor), at that factor
+        struct Level
+        {
+            std::once_flag blurred;
+            Matrix gaussian;
+        };
+        std::map<std::pair<int, int>, std::unique_ptr<Level>> levels; // (level, factor) -> gaussian
+        std::mutex octaves_mutex;
+        std::mutex levels_mutex;
+
+        MatrixView octave(int factor);
+        int previous_level(int level, int factor) const; // blurred from, -1 for the octave
+        static float octave_sigma(int factor);
+        void check_level(int level) const;
+    };
+}
@@ -1,6 +1,8 @@
 #include "HistogramEqualization.hpp"
 #include "helpers/Matrix.hpp"
 
+#include <array>
+
 namespace VisualAlgo::ImagePreprocessingAndEnhancement
 {
 
@@ -23,6 +25,49 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         return result;
     }
 
+    Matrix8u HistogramEqualization::equalize(const Matrix8u &img)
+    {
+        std::array<int, 256> histogram = {};
+        for (int i = 0; i < img.rows; i++)
+        {
+            const uint8_t *row = img[i];
+            for (int j = 0; j < img.cols; j++)
+                histogram[row[j]]++;
+        }
+
+        // Same accumulation order and normalization as the float version
+        const int num_pixels = img.rows * img.cols;
+        std::array<float, 256> cdf = {};
+        float cum_sum = 0, cdf_min = 0, cdf_max = 0;
+        bool first = true;
+        for (int value = 0; value < 256; value++)
+        {
+            if (histogram[value] == 0)
+                continue;
+            cum_sum += static_cast<float>(histogram[value]) / num_pixels;
+            cdf[value] = cum_sum;
+            if (first)
+                cdf_min = cum_sum;
+            cdf_max = cum_sum;
+            first = false;
+        }
+
+        std::array<uint8_t, 256> lut = {};
+        float range = cdf_max - cdf_min;
+        for (int value = 0; value < 256; value++)
+            lut[value] = saturate_cast<uint8_t>(range == 0 ? cdf[value] : ((cdf[value] - cdf_min) / range) * 255);
+
+        Matrix8u result(img.rows, img.cols);
+        for (int i = 0; i < img.rows; i++)
+        {
+            const uint8_t *src = img[i];
+            uint8_t *dst = result[i];
+            for (int j = 0; j < img.cols; j++)
+                dst[j] = lut[src[j]];
+        }
+        return result;
+    }
+
     std::map<float, int> HistogramEqualization::calculate_histogram(const Matrix &img)
     {
         std::map<float, int> histogram;
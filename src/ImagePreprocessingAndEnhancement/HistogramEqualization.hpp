@@ -3,6 +3,7 @@
 #include <vector>
 #include <map>
 #include "helpers/Matrix.hpp"
+#include "helpers/BasicMatrix.hpp"
 
 namespace VisualAlgo::ImagePreprocessingAndEnhancement
 {
@@ -11,6 +12,7 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
     {
     public:
         static Matrix equalize(const Matrix &img);
+        static Matrix8u equalize(const Matrix8u &img); // same result as the float version, rounded; uses a 256-bin histogram and a lookup table
 
     private:
         static std::map<float, int> calculate_histogram(const Matrix &img);
@@ -24,33 +24,43 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         }
     }
 
-    float Interpolate::nearest(const Matrix &image, float x, float y)
+    float Interpolate::pixel(const MatrixView &image, int row, int col, BorderMode border, float value)
+    {
+        row = border_index(row, image.rows, border);
+        col = border_index(col, image.cols, border);
+        if (row < 0 || col < 0)
+            return value;
+        return image[row][col];
+    }
+
+    float Interpolate::nearest(const MatrixView &image, float x, float y, BorderMode border, float value)
     {
         int x_rounded = static_cast<int>(std::floor(x));
         int y_rounded = static_cast<int>(std::floor(y));
 
-        x_rounded = std::clamp(x_rounded, 0, image.cols - 1);
-        y_rounded = std::clamp(y_rounded, 0, image.rows - 1);
-
-        return image.get(y_rounded, x_rounded);
+        return pixel(image, y_rounded, x_rounded, border, value);
     }
 
-    float Interpolate::bilinear(const Matrix &image, float x, float y)
+    float Interpolate::bilinear(const MatrixView &image, float x, float y, BorderMode border, float value)
     {
         int x1 = static_cast<int>(std::floor(x));
         int y1 = static_cast<int>(std::floor(y));
         int x2 = x1 + 1;
         int y2 = y1 + 1;
 
-        x1 = std::clamp(x1, 0, image.cols - 1);
-        y1 = std::clamp(y1, 0, image.rows - 1);
-        x2 = std::clamp(x2, 0, image.cols - 1);
-        y2 = std::clamp(y2, 0, image.rows - 1);
+        // Replicating the edge clamps the corners themselves, weights included
+        if (border == BorderMode::REPLICATE)
+        {
+            x1 = std::clamp(x1, 0, image.cols - 1);
+            y1 = std::clamp(y1, 0, image.rows - 1);
+            x2 = std::clamp(x2, 0, image.cols - 1);
+            y2 = std::clamp(y2, 0, image.rows - 1);
+        }
 
-        float q11 = image.get(y1, x1);
-        float q12 = image.get(y1, x2);
-        float q21 = image.get(y2, x1);
-        float q22 = image.get(y2, x2);
+        float q11 = pixel(image, y1, x1, border, value);
+        float q12 = pixel(image, y1, x2, border, value);
+        float q21 = pixel(image, y2, x1, border, value);
+        float q22 = pixel(image, y2, x2, border, value);
 
         float x2x = x2 - x;
         float xx1 = x - x1;
@@ -69,8 +79,8 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         return p[1] + 0.5 * x * (p[2] - p[0] + 2.0 * x * (2.0 * p[0] - 5.0 * p[1] + 4.0 * p[2] - p[3] + x * (3.0 * (p[1] - p[2]) + p[3] - p[0])));
     }
 
-    // Simplified implementation: no color, no handling of edge cases, not optimized.
-    float Interpolate::bicubic(const Matrix &image, float x, float y)
+    // Simplified implementation: no color, not optimized.
+    float Interpolate::bicubic(const MatrixView &image, float x, float y, BorderMode border, float value)
     {
         int xInt = static_cast<int>(std::round(x));
         int yInt = static_cast<int>(std::round(y));
@@ -83,31 +93,29 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
             float p[4];
             for (int j = 0; j < 4; j++)
             {
-                int xIndex = std::clamp(xInt - 1 + j, 0, image.cols - 1);
-                int yIndex = std::clamp(yInt - 1 + i, 0, image.rows - 1);
-                p[j] = image.get(yIndex, xIndex);
+                p[j] = pixel(image, yInt - 1 + i, xInt - 1 + j, border, value);
             }
             interpolatedCol[i] = cubicInterpolation(p, xFrac);
         }
         return cubicInterpolation(interpolatedCol, yFrac);
     }
 
-    float Interpolate::interpolate(const Matrix &image, float x, float y, InterpolationType type)
+    float Interpolate::interpolate(const MatrixView &image, float x, float y, InterpolationType type, BorderMode border, float value)
     {
         switch (type)
         {
         case InterpolationType::NEAREST:
-            return nearest(image, x, y);
+            return nearest(image, x, y, border, value);
         case InterpolationType::BILINEAR:
-            return bilinear(image, x, y);
+            return bilinear(image, x, y, border, value);
         case InterpolationType::BICUBIC:
-            return bicubic(image, x, y);
+            return bicubic(image, x, y, border, value);
         default:
             throw std::invalid_argument("Invalid interpolation type: " + std::to_string((int)type) + ".");
         }
     }
 
-    float Interpolate::interpolate(const Matrix &image, float x, float y, InterpolationType type, float default_value)
+    float Interpolate::interpolate(const MatrixView &image, float x, float y, InterpolationType type, float default_value)
     {
         if (x < 0 || x >= image.cols || y < 0 || y >= image.rows)
         {
@@ -116,15 +124,15 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         return interpolate(image, x, y, type);
     }
 
-    Matrix Interpolate::interpolate(const Matrix &image, float scale, InterpolationType type)
+    Matrix Interpolate::interpolate(const MatrixView &image, float scale, InterpolationType type, BorderMode border, float value)
     {
         int rows = static_cast<int>(std::round(image.rows * scale));
         int cols = static_cast<int>(std::round(image.cols * scale));
 
-        return interpolate(image, rows, cols, type);
+        return interpolate(image, rows, cols, type, border, value);
     }
 
-    Matrix Interpolate::interpolate(const Matrix &image, int rows, int cols, InterpolationType type)
+    Matrix Interpolate::interpolate(const MatrixView &image, int rows, int cols, InterpolationType type, BorderMode border, float value)
     {
         Matrix result(rows, cols);
 
@@ -147,7 +155,7 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
             for (int j = 0; j < cols; j++)
             {
                 float x = j * x_ratio;
-                result.set(i, j, interpolate(image, x, y, type));
+                result.set(i, j, interpolate(image, x, y, type, border, value));
             }
         }
 
@@ -19,16 +19,19 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
     class Interpolate
     {
     public:
-        static float nearest(const Matrix &image, float x, float y);
-        static float bilinear(const Matrix &image, float x, float y);
-        static float bicubic(const Matrix &image, float x, float y);
+        // Samples that need pixels outside the image extend it with `border`
+        // (clamped to the edge by default); `value` is used by BorderMode::CONSTANT.
+        static float nearest(const MatrixView &image, float x, float y, BorderMode border = BorderMode::REPLICATE, float value = 0);
+        static float bilinear(const MatrixView &image, float x, float y, BorderMode border = BorderMode::REPLICATE, float value = 0);
+        static float bicubic(const MatrixView &image, float x, float y, BorderMode border = BorderMode::REPLICATE, float value = 0);
 
-        static float interpolate(const Matrix &image, float x, float y, InterpolationType type);
-        static float interpolate(const Matrix &image, float x, float y, InterpolationType type, float default_value);
-        static Matrix interpolate(const Matrix &image, float scale, InterpolationType type);
-        static Matrix interpolate(const Matrix &image, int rows, int cols, InterpolationType type);
+        static float interpolate(const MatrixView &image, float x, float y, InterpolationType type, BorderMode border = BorderMode::REPLICATE, float value = 0);
+        static float interpolate(const MatrixView &image, float x, float y, InterpolationType type, float default_value);
+        static Matrix interpolate(const MatrixView &image, float scale, InterpolationType type, BorderMode border = BorderMode::REPLICATE, float value = 0);
+        static Matrix interpolate(const MatrixView &image, int rows, int cols, InterpolationType type, BorderMode border = BorderMode::REPLICATE, float value = 0);
 
     private:
         static float cubicInterpolation(float p[4], float x);
+        static float pixel(const MatrixView &image, int row, int col, BorderMode border, float value);
     };
 }
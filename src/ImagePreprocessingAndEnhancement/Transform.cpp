@@ -1,6 +1,7 @@
 #include "Transform.hpp"
 #include "Interpolate.hpp"
 #include "helpers/Matrix.hpp"
+#include "helpers/SmallMatrix.hpp"
 
 #include <cmath>
 #include <stdexcept>
@@ -17,11 +18,11 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         return affine(image, translate(dx, dy), method);
     }
 
-    Matrix Transform::translate(int dx, int dy)
+    Matrix3 Transform::translate(int dx, int dy)
     {
-        return Matrix({{1, 0, static_cast<float>(dx)},
-                       {0, 1, static_cast<float>(dy)},
-                       {0, 0, 1}});
+        return Matrix3({{1, 0, static_cast<float>(dx)},
+                        {0, 1, static_cast<float>(dy)},
+                        {0, 0, 1}});
     }
 
     // Scaling
@@ -30,11 +31,11 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         return affine(image, scale(sx, sy), method);
     }
 
-    Matrix Transform::scale(float sx, float sy)
+    Matrix3 Transform::scale(float sx, float sy)
     {
-        return Matrix({{sx, 0, 0},
-                       {0, sy, 0},
-                       {0, 0, 1}});
+        return Matrix3({{sx, 0, 0},
+                        {0, sy, 0},
+                        {0, 0, 1}});
     }
 
     // Rotation
@@ -43,11 +44,11 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         return affine(image, rotate(angle), method);
     }
 
-    Matrix Transform::rotate(float angle)
+    Matrix3 Transform::rotate(float angle)
     {
-        return Matrix({{std::cos(angle), -std::sin(angle), 0},
-                       {std::sin(angle), std::cos(angle), 0},
-                       {0, 0, 1}});
+        return Matrix3({{std::cos(angle), -std::sin(angle), 0},
+                        {std::sin(angle), std::cos(angle), 0},
+                        {0, 0, 1}});
     }
 
     // Shear
@@ -56,25 +57,30 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         return affine(image, shear(kx, ky), method);
     }
 
-    Matrix Transform::shear(float kx, float ky)
+    Matrix3 Transform::shear(float kx, float ky)
     {
         if (kx == 1.0f && ky == 1.0f)
         {
             throw std::invalid_argument("Shearing factors kx and ky cannot both be 1, as this would lead to a singular transformation matrix, i.e., the image will collapse into a single line.");
         }
-        return Matrix({{1, kx, 0},
-                       {ky, 1, 0},
-                       {0, 0, 1}});
+        return Matrix3({{1, kx, 0},
+                        {ky, 1, 0},
+                        {0, 0, 1}});
     }
 
     // Affine Transformation
     Matrix Transform::affine(const Matrix &image, const Matrix &transform_matrix, InterpolationType method)
+    {
+        return affine(image, Matrix3(transform_matrix), method);
+    }
+
+    Matrix Transform::affine(const Matrix &image, const Matrix3 &transform_matrix, InterpolationType method)
     {
         auto [center_x, center_y] = center_coords(image);
-        Matrix translation_to_center = Transform::translate(-center_x, -center_y);
-        Matrix translation_to_origin = Transform::translate(center_x, center_y);
+        Matrix3 translation_to_center = Transform::translate(-center_x, -center_y);
+        Matrix3 translation_to_origin = Transform::translate(center_x, center_y);
 
-        Matrix inverse_transform_matrix = transform_matrix.inverse();
+        Matrix3 inverse_transform_matrix = transform_matrix.inverse();
 
         Matrix transformed_image = Matrix::zeros(image.rows, image.cols);
 
@@ -82,16 +88,14 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         {
             for (int x = 0; x < transformed_image.cols; x++)
             {
-                Matrix point = Matrix::ones(3, 1);
-                point.set(0, 0, x);
-                point.set(1, 0, y);
+                Vector3 point{{static_cast<float>(x)}, {static_cast<float>(y)}, {1}};
 
-                Matrix point_in_center = translation_to_center.matmul(point);
-                Matrix transformed_point_in_center = inverse_transform_matrix.matmul(point_in_center);
-                Matrix transformed_point = translation_to_origin.matmul(transformed_point_in_center);
+                Vector3 point_in_center = translation_to_center * point;
+                Vector3 transformed_point_in_center = inverse_transform_matrix * point_in_center;
+                Vector3 transformed_point = translation_to_origin * transformed_point_in_center;
 
-                float transformed_x = transformed_point.get(0, 0);
-                float transformed_y = transformed_point.get(1, 0);
+                float transformed_x = transformed_point[0][0];
+                float transformed_y = transformed_point[1][0];
 
                 transformed_image.set(y, x, Interpolate::interpolate(image, transformed_x, transformed_y, method, 0));
             }
@@ -102,12 +106,17 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
 
     // Perspective Transformation
     Matrix Transform::perspective(const Matrix &image, const Matrix &transform_matrix, InterpolationType method)
+    {
+        return perspective(image, Matrix3(transform_matrix), method);
+    }
+
+    Matrix Transform::perspective(const Matrix &image, const Matrix3 &transform_matrix, InterpolationType method)
     {
         auto [center_x, center_y] = center_coords(image);
-        Matrix translation_to_center = Transform::translate(-center_x, -center_y);
-        Matrix translation_to_origin = Transform::translate(center_x, center_y);
+        Matrix3 translation_to_center = Transform::translate(-center_x, -center_y);
+        Matrix3 translation_to_origin = Transform::translate(center_x, center_y);
 
-        Matrix inverse_transform_matrix = transform_matrix.inverse();
+        Matrix3 inverse_transform_matrix = transform_matrix.inverse();
 
         Matrix transformed_image = Matrix::zeros(image.rows, image.cols);
 
@@ -115,17 +124,15 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         {
             for (int x = 0; x < transformed_image.cols; x++)
             {
-                Matrix point = Matrix::ones(3, 1);
-                point.set(0, 0, x);
-                point.set(1, 0, y);
+                Vector3 point{{static_cast<float>(x)}, {static_cast<float>(y)}, {1}};
 
-                Matrix point_in_center = translation_to_center.matmul(point);
-                Matrix transformed_point_in_center = inverse_transform_matrix.matmul(point_in_center);
-                Matrix transformed_point = translation_to_origin.matmul(transformed_point_in_center);
+                Vector3 point_in_center = translation_to_center * point;
+                Vector3 transformed_point_in_center = inverse_transform_matrix * point_in_center;
+                Vector3 transformed_point = translation_to_origin * transformed_point_in_center;
 
-                float transformed_x = transformed_point.get(0, 0);
-                float transformed_y = transformed_point.get(1, 0);
-                float transformed_z = transformed_point.get(2, 0);
+                float transformed_x = transformed_point[0][0];
+                float transformed_y = transformed_point[1][0];
+                float transformed_z = transformed_point[2][0];
 
                 if (transformed_z < 0)  // Behind the camera, should not be visible
                 {
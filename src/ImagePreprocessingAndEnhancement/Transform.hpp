@@ -1,6 +1,7 @@
 #pragma once
 
 #include "helpers/Matrix.hpp"
+#include "helpers/SmallMatrix.hpp"
 #include "Interpolate.hpp"
 
 #include <utility>
@@ -15,28 +16,30 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         // Translation
         static Matrix translate(const Matrix &image, int dx, int dy, InterpolationType method = InterpolationType::NEAREST);
 
-        static Matrix translate(int dx, int dy);
+        static Matrix3 translate(int dx, int dy);
 
         // Scaling
         static Matrix scale(const Matrix &image, float sx, float sy, InterpolationType method = InterpolationType::NEAREST);
 
-        static Matrix scale(float sx, float sy);
+        static Matrix3 scale(float sx, float sy);
 
         // Rotation
         static Matrix rotate(const Matrix &image, float angle, InterpolationType method = InterpolationType::NEAREST);
 
-        static Matrix rotate(float angle);
+        static Matrix3 rotate(float angle);
 
         // Shear
         static Matrix shear(const Matrix &image, float kx, float ky, InterpolationType method = InterpolationType::NEAREST);
 
-        static Matrix shear(float kx, float ky);
+        static Matrix3 shear(float kx, float ky);
 
         // Affine Transformation
-        static Matrix affine(const Matrix &image, const Matrix &transform_matrix, InterpolationType method = InterpolationType::NEAREST);
+        static Matrix affine(const Matrix &image, const Matrix3 &transform_matrix, InterpolationType method = InterpolationType::NEAREST);
+        static Matrix affine(const Matrix &image, const Matrix &transform_matrix, InterpolationType method = InterpolationType::NEAREST); // transform_matrix must be 3x3
 
         // Perspective Transformation
-        static Matrix perspective(const Matrix &image, const Matrix &transform_matrix, InterpolationType method = InterpolationType::NEAREST);
+        static Matrix perspective(const Matrix &image, const Matrix3 &transform_matrix, InterpolationType method = InterpolationType::NEAREST);
+        static Matrix perspective(const Matrix &image, const Matrix &transform_matrix, InterpolationType method = InterpolationType::NEAREST); // transform_matrix must be 3x3
 
     private:
         static std::pair<float, float> center_coords(const Matrix &image);
@@ -1,11 +1,14 @@
 #include "FBF.hpp"
 #include "helpers/Matrix.hpp"
+#include "helpers/FilterBank.hpp"
+#include "helpers/KernelCache.hpp"
 #include "helpers/ProgressBar.hpp"
 
 #include <cmath>
 #include <stdexcept>
 #include <vector>
 #include <string>
+#include <utility>
 
 // Grossberg and Wyse (1992) take the log inside of the exponential. This is not a standard gaussian function.
 static float gaussian(float p, float q, float i, float j, float C_or_E, float alpha_or_beta)
@@ -15,7 +18,7 @@ static float gaussian(float p, float q, float i, float j, float C_or_E, float al
     return C_or_E * exp(-pow(alpha_or_beta, -2) * (2 * (p - i) * (p - i) + 2 * (q - j) * (q - j)));
 }
 
-static VisualAlgo::Matrix gaussian(int rows, int cols, float C_or_E, float alpha_or_beta)
+static VisualAlgo::Matrix build_gaussian(int rows, int cols, float C_or_E, float alpha_or_beta)
 {
     VisualAlgo::Matrix matrix(rows, cols, 0);
     float center_x = matrix.rows / 2;
@@ -30,7 +33,7 @@ static VisualAlgo::Matrix gaussian(int rows, int cols, float C_or_E, float alpha
     return matrix;
 }
 
-static VisualAlgo::Matrix half_ellipse(int major_axis, int minor_axis, float theta, float fill_value = 1, bool is_left = true)
+static VisualAlgo::Matrix build_half_ellipse(int major_axis, int minor_axis, float theta, float fill_value, bool is_left)
 {
     int KERNEL_SIZE = static_cast<int>(major_axis * 1.8);
     VisualAlgo::Matrix matrix(KERNEL_SIZE, KERNEL_SIZE, 0);
@@ -54,32 +57,72 @@ static VisualAlgo::Matrix half_ellipse(int major_axis, int minor_axis, float the
     return matrix;
 }
 
+static VisualAlgo::Matrix build_oriented_competition_kernel(int size, float theta)
+{
+    VisualAlgo::Matrix kernel(size, size, 1);
+    for (int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < size; j++)
+        {
+            float x = i - size / 2;
+            float y = j - size / 2;
+            float rotated_y = x * sin(theta) + y * cos(theta);
+            if (abs(rotated_y) <= 0.5)
+            {
+                kernel.set(i, j, 0);
+            }
+        }
+    }
+
+    kernel /= kernel.sum();
+    kernel.save("results/SegmentationAndGrouping/FBF/oriented_competition_kernel_" + std::to_string(theta) + ".ppm", true);
+
+    return kernel;
+}
+
+// The kernels are the same for every frame, they are only built the first time
+static VisualAlgo::KernelCache::Kernel gaussian(int rows, int cols, float C_or_E, float alpha_or_beta)
+{
+    return VisualAlgo::KernelCache::global().get("fbf_gaussian", {(float)rows, (float)cols, C_or_E, alpha_or_beta}, [&]()
+                                                 { return build_gaussian(rows, cols, C_or_E, alpha_or_beta); });
+}
+
+static VisualAlgo::KernelCache::Kernel half_ellipse(int major_axis, int minor_axis, float theta, float fill_value = 1, bool is_left = true)
+{
+    return VisualAlgo::KernelCache::global().get("fbf_half_ellipse", {(float)major_axis, (float)minor_axis, theta, fill_value, (float)is_left}, [&]()
+                                                 { return build_half_ellipse(major_axis, minor_axis, theta, fill_value, is_left); });
+}
+
 namespace VisualAlgo::SegmentationAndGrouping
 {
     ShuntingCell::ShuntingCell() {}
 
-    Matrix ShuntingOnCell::apply(Matrix input)
+    Matrix ShuntingOnCell::apply(const Matrix &input)
     {
-        Matrix on_center_off_surround = gaussian(KERNEL_SIZE, KERNEL_SIZE, C, ALPHA) * B - gaussian(KERNEL_SIZE, KERNEL_SIZE, E, BETA) * D;
-        Matrix numerator = input.cross_correlate(on_center_off_surround, KERNEL_SIZE / 2, 1);
+        KernelCache::Kernel center = gaussian(KERNEL_SIZE, KERNEL_SIZE, C, ALPHA), surround = gaussian(KERNEL_SIZE, KERNEL_SIZE, E, BETA);
+        Matrix on_center_off_surround = *center * B - *surround * D;
+        Matrix denominator_kernel = *center + *surround;
 
-        Matrix denominator_kernel = gaussian(KERNEL_SIZE, KERNEL_SIZE, C, ALPHA) + gaussian(KERNEL_SIZE, KERNEL_SIZE, E, BETA);
-        Matrix denominator = input.cross_correlate(denominator_kernel, KERNEL_SIZE / 2, 1) + A;
+        // Both kernels in one pass over the input
+        std::vector<Matrix> outputs = FilterBank({on_center_off_surround, denominator_kernel}).cross_correlate(input, KERNEL_SIZE / 2, 1);
+        Matrix numerator = std::move(outputs[0]);
+        Matrix denominator = std::move(outputs[1]) + A;
 
-        Matrix output = numerator / denominator;
-        return output;
+        return std::move(numerator) / denominator;
     }
 
-    Matrix ShuntingOffCell::apply(Matrix input)
+    Matrix ShuntingOffCell::apply(const Matrix &input)
     {
-        Matrix off_center_on_surround = gaussian(KERNEL_SIZE, KERNEL_SIZE, E, BETA) * D - gaussian(KERNEL_SIZE, KERNEL_SIZE, C, ALPHA) * B;
-        Matrix numerator = input.cross_correlate(off_center_on_surround, KERNEL_SIZE / 2, 1) + A * S;
+        KernelCache::Kernel center = gaussian(KERNEL_SIZE, KERNEL_SIZE, C, ALPHA), surround = gaussian(KERNEL_SIZE, KERNEL_SIZE, E, BETA);
+        Matrix off_center_on_surround = *surround * D - *center * B;
+        Matrix denominator_kernel = *center + *surround;
 
-        Matrix denominator_kernel = gaussian(KERNEL_SIZE, KERNEL_SIZE, C, ALPHA) + gaussian(KERNEL_SIZE, KERNEL_SIZE, E, BETA);
-        Matrix denominator = input.cross_correlate(denominator_kernel, KERNEL_SIZE / 2, 1) + A;
+        // Both kernels in one pass over the input
+        std::vector<Matrix> outputs = FilterBank({off_center_on_surround, denominator_kernel}).cross_correlate(input, KERNEL_SIZE / 2, 1);
+        Matrix numerator = std::move(outputs[0]) + A * S;
+        Matrix denominator = std::move(outputs[1]) + A;
 
-        Matrix output = numerator / denominator;
-        return output;
+        return std::move(numerator) / denominator;
     }
 
     SimpleCell::SimpleCell(float theta, int scale, bool is_left) : theta(theta), scale(scale), is_left(is_left)
@@ -101,47 +144,65 @@ namespace VisualAlgo::SegmentationAndGrouping
         }
     }
 
-    Matrix SimpleCell::apply(Matrix input)
+    Matrix SimpleCell::kernel() const
     {
         // Precompute the kernels. There are two halves.
-        Matrix L_kernel = half_ellipse(major_axis, minor_axis, theta, 1, true);
-        Matrix R_kernel = half_ellipse(major_axis, minor_axis, theta, 1, false);
+        KernelCache::Kernel L_kernel = half_ellipse(major_axis, minor_axis, theta, 1, true);
+        KernelCache::Kernel R_kernel = half_ellipse(major_axis, minor_axis, theta, 1, false);
         Matrix whole_kernel;
         if (is_left)
         {
-            whole_kernel = L_kernel - R_kernel * alpha - beta;
+            whole_kernel = *L_kernel - *R_kernel * alpha - beta;
         }
         else
         {
-            whole_kernel = R_kernel - L_kernel * alpha - beta;
+            whole_kernel = *R_kernel - *L_kernel * alpha - beta;
         }
 
         // Normalize the kernel.
         whole_kernel /= whole_kernel.sum();
 
+        return whole_kernel;
+    }
+
+    Matrix SimpleCell::apply(const Matrix &input)
+    {
+        return std::move(apply({*this}, input)[0]);
+    }
+
+    std::vector<Matrix> SimpleCell::apply(const std::vector<SimpleCell> &cells, const Matrix &input)
+    {
+        // All cells of a scale have kernels of the same size, so they run as one filter bank.
+        FilterBank bank;
+        for (const SimpleCell &cell : cells)
+        {
+            if (cell.major_axis != cells[0].major_axis)
+                throw std::invalid_argument("Simple cells applied together must have the same scale");
+            bank.add(cell.kernel());
+        }
+
         // Cross correlate the kernels with the input.
-        Matrix output = input.cross_correlate(whole_kernel, major_axis / 2, 1);
+        std::vector<Matrix> outputs = bank.cross_correlate(input, cells[0].major_axis / 2, 1);
 
-        // Rectify the output.
-        output.relu();
+        // Rectify the outputs.
+        for (Matrix &output : outputs)
+            output.relu();
 
-        return output;
+        return outputs;
     }
 
     ComplexCell::ComplexCell() {}
 
-    Matrix ComplexCell::apply(Matrix simple_on_l, Matrix simple_on_r, Matrix simple_off_l, Matrix simple_off_r)
+    Matrix ComplexCell::apply(const Matrix &simple_on_l, const Matrix &simple_on_r, const Matrix &simple_off_l, const Matrix &simple_off_r)
     {
-        Matrix output(simple_on_l.rows, simple_on_l.cols, 0);
-        output = (simple_on_l + simple_on_r + simple_off_l + simple_off_r) * F;
-        return output;
+        return (simple_on_l + simple_on_r + simple_off_l + simple_off_r) * F;
     }
 
     HypercomplexCellFirstCompetitiveStage::HypercomplexCellFirstCompetitiveStage(int scale) : scale(scale)
     {
     }
 
-    VisualAlgo::Matrix HypercomplexCellFirstCompetitiveStage::oriented_competition_kernel(float theta)
+    KernelCache::Kernel HypercomplexCellFirstCompetitiveStage::oriented_competition_kernel(float theta)
     {
         int KERNEL_SIZE;
         if (scale == 1)
@@ -152,25 +213,10 @@ namespace VisualAlgo::SegmentationAndGrouping
         {
             KERNEL_SIZE = 16;
         }
-        Matrix kernel(KERNEL_SIZE, KERNEL_SIZE, 1);
-        for (int i = 0; i < KERNEL_SIZE; i++)
-        {
-            for (int j = 0; j < KERNEL_SIZE; j++)
-            {
-                float x = i - KERNEL_SIZE / 2;
-                float y = j - KERNEL_SIZE / 2;
-                float rotated_y = x * sin(theta) + y * cos(theta);
-                if (abs(rotated_y) <= 0.5)
-                {
-                    kernel.set(i, j, 0);
-                }
-            }
-        }
 
-        kernel /= kernel.sum();
-        kernel.save("results/SegmentationAndGrouping/FBF/oriented_competition_kernel_" + std::to_string(theta) + ".ppm", true);
-
-        return kernel;
+        // Built, and saved for inspection, once per orientation and size
+        return KernelCache::global().get("fbf_oriented_competition", {(float)KERNEL_SIZE, theta}, [&]()
+                                         { return build_oriented_competition_kernel(KERNEL_SIZE, theta); });
     }
 
     std::vector<Matrix> HypercomplexCellFirstCompetitiveStage::apply(const std::vector<Matrix> &complex_cells)
@@ -178,23 +224,19 @@ namespace VisualAlgo::SegmentationAndGrouping
         std::vector<Matrix> output;
         for (int theta_i = 0; theta_i < complex_cells.size(); theta_i++)
         {
-            Matrix G = oriented_competition_kernel(theta_i * THETA_INCREMENT);
-
-            Matrix denominator = Matrix(complex_cells[theta_i].rows, complex_cells[theta_i].cols, 0);
+            KernelCache::Kernel G = oriented_competition_kernel(theta_i * THETA_INCREMENT);
 
-            for (int theta_j = 0; theta_j < complex_cells.size(); theta_j++)
-            {
-                denominator += complex_cells[theta_i].cross_correlate(G);
-            }
+            // Every term of the sum over theta_j is the same correlation, so it is computed once.
+            Matrix denominator = complex_cells[theta_i].cross_correlate(*G) * static_cast<float>(complex_cells.size());
             denominator = denominator * MU + EPSILON;
 
-            Matrix numerator = complex_cells[theta_i];
+            const Matrix &numerator = complex_cells[theta_i];
 
-            Matrix D = (numerator / denominator) - TAU;
+            Matrix D = (numerator / std::move(denominator)) - TAU;
 
             D.relu();
 
-            output.push_back(D);
+            output.push_back(std::move(D));
         }
         return output;
     }
@@ -212,7 +254,7 @@ namespace VisualAlgo::SegmentationAndGrouping
         debug_dir = dir;
     }
 
-    Matrix FBF::apply(Matrix input)
+    Matrix FBF::apply(const Matrix &input)
     {
         int NUM_STEPS = 9;  // number of step() calls by the progress bar
         ProgressBar progressBar(NUM_STEPS, "Applying FBF");
@@ -237,14 +279,24 @@ namespace VisualAlgo::SegmentationAndGrouping
         std::vector<Matrix> complex_cells_scale_2; // 8 orientations
         for (int s = 1; s <= 2; s++)
         {
+            // Step 2a: Simple Cells. The 16 kernels of a scale (8 orientations,
+            // left and right halves) are applied as one filter bank.
+            std::vector<SimpleCell> simple_cells;
             for (int i = 0; i < 8; i++)
             {
                 float theta = i * THETA_INCREMENT;
-                // Step 2a: Simple Cells
-                auto simple_on_l = SimpleCell(theta, s, true).apply(shunting_on_output);
-                auto simple_on_r = SimpleCell(theta, s, false).apply(shunting_on_output);
-                auto simple_off_l = SimpleCell(theta, s, true).apply(shunting_off_output);
-                auto simple_off_r = SimpleCell(theta, s, false).apply(shunting_off_output);
+                simple_cells.push_back(SimpleCell(theta, s, true));
+                simple_cells.push_back(SimpleCell(theta, s, false));
+            }
+            std::vector<Matrix> simple_on = SimpleCell::apply(simple_cells, shunting_on_output);
+            std::vector<Matrix> simple_off = SimpleCell::apply(simple_cells, shunting_off_output);
+
+            for (int i = 0; i < 8; i++)
+            {
+                const Matrix &simple_on_l = simple_on[2 * i];
+                const Matrix &simple_on_r = simple_on[2 * i + 1];
+                const Matrix &simple_off_l = simple_off[2 * i];
+                const Matrix &simple_off_r = simple_off[2 * i + 1];
 
                 if (debug_dir != "")
                 {
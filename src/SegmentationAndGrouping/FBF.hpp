@@ -6,6 +6,7 @@
 #include <string>
 
 #include "helpers/Matrix.hpp"
+#include "helpers/KernelCache.hpp"
 
 #ifndef DEBUG
 #define DEBUG 0
@@ -26,19 +27,19 @@ namespace VisualAlgo::SegmentationAndGrouping
 
         ShuntingCell();
 
-        virtual Matrix apply(Matrix input) = 0; // Pure virtual function
+        virtual Matrix apply(const Matrix &input) = 0; // Pure virtual function
     };
 
     struct ShuntingOnCell : public ShuntingCell
     {
-        Matrix apply(Matrix input) override;
+        Matrix apply(const Matrix &input) override;
     };
 
     struct ShuntingOffCell : public ShuntingCell
     {
         float S = 0.2;
 
-        Matrix apply(Matrix input) override;
+        Matrix apply(const Matrix &input) override;
     };
 
     struct SimpleCell
@@ -52,7 +53,9 @@ namespace VisualAlgo::SegmentationAndGrouping
 
         SimpleCell(float theta, int scale, bool is_left);
 
-        Matrix apply(Matrix input);
+        Matrix kernel() const;
+        Matrix apply(const Matrix &input);
+        static std::vector<Matrix> apply(const std::vector<SimpleCell> &cells, const Matrix &input); // one output per cell, same scale
     };
 
     struct ComplexCell
@@ -61,7 +64,7 @@ namespace VisualAlgo::SegmentationAndGrouping
 
         ComplexCell();
 
-        Matrix apply(Matrix simple_on_l, Matrix simple_on_r, Matrix simple_off_l, Matrix simple_off_r);
+        Matrix apply(const Matrix &simple_on_l, const Matrix &simple_on_r, const Matrix &simple_off_l, const Matrix &simple_off_r);
     };
 
     struct HypercomplexCellFirstCompetitiveStage
@@ -74,7 +77,7 @@ namespace VisualAlgo::SegmentationAndGrouping
 
         HypercomplexCellFirstCompetitiveStage(int scale);
 
-        VisualAlgo::Matrix oriented_competition_kernel(float theta);
+        KernelCache::Kernel oriented_competition_kernel(float theta); // shared, built on first use
 
         std::vector<Matrix> apply(const std::vector<Matrix> &complex_cells);
     };
@@ -86,7 +89,7 @@ namespace VisualAlgo::SegmentationAndGrouping
         ~FBF();
 
         void set_debug_dir(std::string dir);
-        Matrix apply(Matrix input);
+        Matrix apply(const Matrix &input);
 
     private:
         const float THETA_INCREMENT = M_PI / 8;
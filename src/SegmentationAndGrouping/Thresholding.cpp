@@ -22,4 +22,19 @@ namespace VisualAlgo::SegmentationAndGrouping
         return result;
     }
 
+    Matrix8u Thresholding::mask(const MatrixView &img, float threshold)
+    {
+        Matrix8u result(img.rows, img.cols);
+
+        for (int i = 0; i < img.rows; ++i)
+        {
+            const float *src = img[i];
+            uint8_t *dst = result[i];
+            for (int j = 0; j < img.cols; ++j)
+                dst[j] = src[j] > threshold ? 255 : 0;
+        }
+
+        return result;
+    }
+
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "helpers/Matrix.hpp"
+#include "helpers/BasicMatrix.hpp"
 
 namespace VisualAlgo::SegmentationAndGrouping
 {
@@ -10,6 +11,9 @@ namespace VisualAlgo::SegmentationAndGrouping
     public:
         // Binary thresholding
         static Matrix apply(const Matrix &img, float threshold);
+
+        // Same as apply, as an 8-bit mask (255 foreground, 0 background)
+        static Matrix8u mask(const MatrixView &img, float threshold);
     };
 
 }
@@ -0,0 +1,223 @@
+#include "BasicMatrix.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace VisualAlgo
+{
+    // Constructors
+    template <typename T>
+    BasicMatrix<T>::BasicMatrix()
+    {
+        this->rows = 0;
+        this->cols = 0;
+        this->stride = 0;
+    }
+
+    template <typename T>
+    BasicMatrix<T>::BasicMatrix(int rows, int cols) : BasicMatrix(rows, cols, T())
+    {
+    }
+
+    template <typename T>
+    BasicMatrix<T>::BasicMatrix(int rows, int cols, T value)
+    {
+        if (rows < 0 || cols < 0)
+            throw std::invalid_argument("Matrix dimensions must be positive");
+        this->rows = rows;
+        this->cols = cols;
+        this->stride = cols;
+        this->data = std::vector<T>(static_cast<size_t>(rows) * cols, value);
+    }
+
+    template <typename T>
+    BasicMatrix<T>::BasicMatrix(std::initializer_list<std::initializer_list<T>> data)
+    {
+        this->rows = data.size();
+        this->cols = data.size() > 0 ? data.begin()->size() : 0;
+        this->stride = this->cols;
+        this->data.reserve(static_cast<size_t>(this->rows) * this->cols);
+        for (const auto &row : data)
+        {
+            if (static_cast<int>(row.size()) != this->cols)
+                throw std::invalid_argument("All rows must have the same number of columns");
+            this->data.insert(this->data.end(), row.begin(), row.end());
+        }
+    }
+
+    template <typename T>
+    BasicMatrix<T>::BasicMatrix(const MatrixView &matrix) : BasicMatrix(matrix.rows, matrix.cols)
+    {
+        for (int i = 0; i < this->rows; i++)
+        {
+            const float *src = matrix[i];
+            T *dst = (*this)[i];
+            for (int j = 0; j < this->cols; j++)
+                dst[j] = saturate_cast<T>(src[j]);
+        }
+    }
+
+    // Conversions
+    template <typename T>
+    Matrix BasicMatrix<T>::to_matrix() const
+    {
+        Matrix result(this->rows, this->cols);
+        for (int i = 0; i < this->rows; i++)
+        {
+            const T *src = (*this)[i];
+            float *dst = result[i];
+            for (int j = 0; j < this->cols; j++)
+                dst[j] = static_cast<float>(src[j]);
+        }
+        return result;
+    }
+
+    // Comparison
+    template <typename T>
+    bool BasicMatrix<T>::operator==(const BasicMatrix &other) const
+    {
+        if (this->rows != other.rows || this->cols != other.cols)
+            return false;
+        for (int i = 0; i < this->rows; i++)
+            if (!std::equal((*this)[i], (*this)[i] + this->cols, other[i]))
+                return false;
+        return true;
+    }
+
+    template <typename T>
+    bool BasicMatrix<T>::operator!=(const BasicMatrix &other) const
+    {
+        return !(*this == other);
+    }
+
+    // Accessors
+    template <typename T>
+    void BasicMatrix<T>::set(int row, int col, T value)
+    {
+        if (row < 0 || row >= this->rows || col < 0 || col >= this->cols)
+            throw std::out_of_range("Matrix index (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+        this->data[static_cast<size_t>(row) * this->stride + col] = value;
+    }
+
+    template <typename T>
+    T BasicMatrix<T>::get(int row, int col) const
+    {
+        if (row < 0 || row >= this->rows || col < 0 || col >= this->cols)
+            throw std::out_of_range("Matrix index (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+        return this->data[static_cast<size_t>(row) * this->stride + col];
+    }
+
+    template <typename T>
+    T *BasicMatrix<T>::operator[](int row)
+    {
+        check_row(row);
+        return this->data.data() + static_cast<size_t>(row) * this->stride;
+    }
+
+    template <typename T>
+    const T *BasicMatrix<T>::operator[](int row) const
+    {
+        check_row(row);
+        return this->data.data() + static_cast<size_t>(row) * this->stride;
+    }
+
+    // Statistics
+    template <typename T>
+    T BasicMatrix<T>::max() const
+    {
+        this->get(0, 0); // throws on an empty matrix
+        return *std::max_element(this->data.begin(), this->data.end());
+    }
+
+    template <typename T>
+    T BasicMatrix<T>::min() const
+    {
+        this->get(0, 0); // throws on an empty matrix
+        return *std::min_element(this->data.begin(), this->data.end());
+    }
+
+    // Image operations
+    template <typename T>
+    void BasicMatrix<T>::load(const std::string &filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open file: " + filename + ".");
+        }
+
+        std::string header;
+        file >> header;
+        if (header != "P6")
+        {
+            throw std::runtime_error("Can only handle PPM format (P6). Got: " + header + " instead.");
+        }
+
+        int rows, cols, max_value;
+        file >> cols >> rows >> max_value;
+        file.get(); // consume newline
+
+        *this = BasicMatrix(rows, cols);
+
+        std::vector<unsigned char> scanline(static_cast<size_t>(cols) * 3);
+        for (int i = 0; i < rows; ++i)
+        {
+            file.read(reinterpret_cast<char *>(scanline.data()), scanline.size());
+            T *row = (*this)[i];
+            for (int j = 0; j < cols; ++j)
+            {
+                // same ITU-R BT.709 luma transform as Matrix::load
+                float luma = 0.2126 * scanline[3 * j] + 0.7152 * scanline[3 * j + 1] + 0.0722 * scanline[3 * j + 2];
+                row[j] = saturate_cast<T>(luma);
+            }
+        }
+    }
+
+    template <typename T>
+    void BasicMatrix<T>::save(const std::string &filename) const
+    {
+        if (this->rows > 0 && this->cols > 0 && (this->max() > 255 || this->min() < 0))
+        {
+            throw std::runtime_error("Image values must be between 0 and 255. Please consider normalizing.");
+        }
+
+        std::ofstream file(filename, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open file: " + filename + ".");
+        }
+
+        file << "P6\n";
+        file << this->cols << " " << this->rows << "\n";
+        file << 255 << "\n";
+
+        std::vector<unsigned char> scanline(static_cast<size_t>(this->cols) * 3);
+        for (int i = 0; i < this->rows; ++i)
+        {
+            const T *row = (*this)[i];
+            for (int j = 0; j < this->cols; ++j)
+            {
+                unsigned char pixel = static_cast<unsigned char>(row[j]);
+                scanline[3 * j] = pixel;     // R
+                scanline[3 * j + 1] = pixel; // G
+                scanline[3 * j + 2] = pixel; // B
+            }
+            file.write(reinterpret_cast<char *>(scanline.data()), scanline.size());
+        }
+    }
+
+    // Private
+    template <typename T>
+    void BasicMatrix<T>::check_row(int row) const
+    {
+        if (row < 0 || row >= this->rows)
+            throw std::out_of_range("Matrix row " + std::to_string(row) + " out of range");
+    }
+
+    template struct BasicMatrix<uint8_t>;
+    template struct BasicMatrix<uint16_t>;
+    template struct BasicMatrix<float>;
+    template struct BasicMatrix<double>;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Matrix.hpp"
+
+namespace VisualAlgo
+{
+    // Converts to T, rounding half away from zero and clamping to the range of T when T
+    // is an integer type. NaN becomes 0.
+    template <typename T>
+    inline T saturate_cast(double value)
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            if (std::isnan(value))
+                return 0;
+            value = std::round(value);
+            if (value <= static_cast<double>(std::numeric_limits<T>::lowest()))
+                return std::numeric_limits<T>::lowest();
+            if (value >= static_cast<double>(std::numeric_limits<T>::max()))
+                return std::numeric_limits<T>::max();
+            return static_cast<T>(value);
+        }
+        else
+            return static_cast<T>(value);
+    }
+
+    // Row-major matrix over an arbitrary pixel type, for data that does not
+    // need 32-bit floats: 8-bit images and binary masks take a quarter of the
+    // memory of a Matrix, and integer kernels can work on them directly.
+    //
+    // Matrix stays the float type the algorithms compute with (expression
+    // templates, SIMD kernels, convolution); BasicMatrix only stores pixels and
+    // converts to and from it. It is instantiated for uint8_t, uint16_t, float
+    // and double (see the aliases below).
+    template <typename T>
+    struct BasicMatrix
+    {
+        // Attributes
+        int rows, cols;
+        int stride;          // distance (in elements) between the starts of two consecutive rows
+        std::vector<T> data; // contiguous row-major buffer, element (i, j) is data[i * stride + j]
+
+        // Constructors
+        BasicMatrix();
+        BasicMatrix(int rows, int cols);
+        BasicMatrix(int rows, int cols, T value);
+        BasicMatrix(std::initializer_list<std::initializer_list<T>> data);
+        explicit BasicMatrix(const MatrixView &matrix); // rounds and saturates, see saturate_cast
+
+        // Conversions
+        Matrix to_matrix() const;
+        template <typename U>
+        BasicMatrix<U> convert() const; // rounds and saturates, see saturate_cast
+
+        // Comparison
+        bool operator==(const BasicMatrix &other) const;
+        bool operator!=(const BasicMatrix &other) const;
+
+        // Accessors
+        void set(int row, int col, T value);
+        T get(int row, int col) const;
+        T *operator[](int row); // pointer to the first element of the row
+        const T *operator[](int row) const;
+
+        // Statistics
+        T max() const;
+        T min() const;
+
+        // Image operations
+        void load(const std::string &filename);     // PPM (P6), converted to grayscale like Matrix::load
+        void save(const std::string &filename) const; // values must be between 0 and 255
+
+    private:
+        void check_row(int row) const;
+    };
+
+    using Matrix8u = BasicMatrix<uint8_t>;
+    using Matrix16u = BasicMatrix<uint16_t>;
+    using Matrix32f = BasicMatrix<float>;
+    using Matrix64f = BasicMatrix<double>;
+
+    template <typename T>
+    template <typename U>
+    BasicMatrix<U> BasicMatrix<T>::convert() const
+    {
+        BasicMatrix<U> result(this->rows, this->cols);
+        for (int i = 0; i < this->rows; i++)
+        {
+            const T *src = (*this)[i];
+            U *dst = result[i];
+            for (int j = 0; j < this->cols; j++)
+                dst[j] = saturate_cast<U>(src[j]);
+        }
+        return result;
+    }
+
+    extern template struct BasicMatrix<uint8_t>;
+    extern template struct BasicMatrix<uint16_t>;
+    extern template struct BasicMatrix<float>;
+    extern template struct BasicMatrix<double>;
+}
@@ -0,0 +1,67 @@
+#include "Border.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace VisualAlgo
+{
+    std::string to_string(BorderMode mode)
+    {
+        switch (mode)
+        {
+        case BorderMode::CONSTANT:
+            return "constant";
+        case BorderMode::REPLICATE:
+            return "replicate";
+        case BorderMode::REFLECT:
+            return "reflect";
+        case BorderMode::REFLECT_101:
+            return "reflect_101";
+        case BorderMode::WRAP:
+            return "wrap";
+        default:
+            return "unknown";
+        }
+    }
+
+    int border_index(int index, int size, BorderMode mode)
+    {
+        if (index >= 0 && index < size)
+            return index;
+        if (mode == BorderMode::CONSTANT)
+            return -1;
+        if (size <= 0)
+            throw std::invalid_argument("Cannot extend an empty image with border mode " + to_string(mode) + ".");
+
+        switch (mode)
+        {
+        case BorderMode::REPLICATE:
+            return index < 0 ? 0 : size - 1;
+        case BorderMode::REFLECT:
+        {
+            // Period 2 * size: abcdefgh hgfedcba
+            int period = 2 * size;
+            index %= period;
+            if (index < 0)
+                index += period;
+            return index < size ? index : period - 1 - index;
+        }
+        case BorderMode::REFLECT_101:
+        {
+            // Period 2 * size - 2: abcdefgh gfedcb
+            if (size == 1)
+                return 0;
+            int period = 2 * size - 2;
+            index %= period;
+            if (index < 0)
+                index += period;
+            return index < size ? index : period - index;
+        }
+        case BorderMode::WRAP:
+            index %= size;
+            return index < 0 ? index + size : index;
+        default:
+            throw std::invalid_argument("Invalid border mode: " + std::to_string((int)mode) + ".");
+        }
+    }
+}
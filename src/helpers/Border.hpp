@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+namespace VisualAlgo
+{
+    // How an image is extended beyond its edges, shown for the row abcdefgh
+    enum class BorderMode
+    {
+        CONSTANT,    // iiiiii|abcdefgh|iiiiii, with a given value i
+        REPLICATE,   // aaaaaa|abcdefgh|hhhhhh
+        REFLECT,     // fedcba|abcdefgh|hgfedc
+        REFLECT_101, // gfedcb|abcdefgh|gfedcb, the edge pixel is not repeated
+        WRAP         // cdefgh|abcdefgh|abcdef
+    };
+
+    std::string to_string(BorderMode mode);
+
+    // Maps a coordinate of an extended row or column of `size` pixels back to
+    // [0, size). Returns -1 outside the image for CONSTANT, where the caller
+    // uses the constant value instead. Works for any distance from the edge.
+    int border_index(int index, int size, BorderMode mode);
+}
@@ -0,0 +1,342 @@
+#include "Convolution.hpp"
+#include "ConvolutionPlanner.hpp"
+#include "FFT.hpp"
+#include "Gemm.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace VisualAlgo::Convolution
+{
+    std::string to_string(Method method)
+    {
+        switch (method)
+        {
+        case Method::AUTO:
+            return "auto";
+        case Method::DIRECT:
+            return "direct";
+        case Method::SEPARABLE:
+            return "separable";
+        case Method::FFT:
+            return "fft";
+        case Method::GEMM:
+            return "gemm";
+        default:
+            return "unknown";
+        }
+    }
+
+    namespace
+    {
+        std::atomic<bool> planned_auto = false;
+
+        // Copies a row or column vector into a contiguous row of taps
+        Matrix taps(const MatrixView &factor, const std::string &name)
+        {
+            if (factor.rows != 1 && factor.cols != 1)
+                throw std::invalid_argument("The " + name + " factor of a separable kernel must be a vector. Got " + std::to_string(factor.rows) + "x" + std::to_string(factor.cols) + " instead.");
+            if (factor.rows == 0 || factor.cols == 0)
+                throw std::invalid_argument("Kernel cannot be empty.");
+            Matrix result(1, factor.rows * factor.cols);
+            for (int i = 0; i < factor.rows; i++)
+                for (int j = 0; j < factor.cols; j++)
+                    result[0][i * factor.cols + j] = factor[i][j];
+            return result;
+        }
+
+        // Every input row is used for all kernels while it is in cache
+        std::vector<Matrix> correlate_direct(const MatrixView &input, const std::vector<MatrixView> &kernels, int stride)
+        {
+            const int kernel_rows = kernels[0].rows, kernel_cols = kernels[0].cols;
+            int out_rows = (input.rows - kernel_rows) / stride + 1;
+            int out_cols = (input.cols - kernel_cols) / stride + 1;
+            std::vector<Matrix> outputs(kernels.size(), Matrix(out_rows, out_cols, 0));
+
+            // Unrolled kernels for the common small sizes, one pass per output row
+            if (stride == 1 && kernel_rows == kernel_cols && Simd::has_correlate_square(kernel_rows))
+            {
+                std::vector<Matrix> taps;
+                for (const MatrixView &kernel : kernels)
+                    taps.push_back(kernel.to_matrix());
+                std::vector<const float *> rows(kernel_rows);
+                for (int i = 0; i < out_rows; ++i)
+                {
+                    for (int p = 0; p < kernel_rows; ++p)
+                        rows[p] = input[i + p];
+                    for (size_t n = 0; n < kernels.size(); ++n)
+                        Simd::correlate_square(rows.data(), taps[n].data.data(), kernel_rows, outputs[n][i], out_cols);
+                }
+                return outputs;
+            }
+
+            for (int i = 0; i < out_rows; ++i)
+            {
+                for (int p = 0; p < kernel_rows; ++p)
+                {
+                    const float *in = input[stride * i + p];
+                    for (size_t n = 0; n < kernels.size(); ++n)
+                    {
+                        float *out = outputs[n][i];
+                        const float *k = kernels[n][p];
+                        if (stride == 1)
+                        {
+                            Simd::correlate_row(in, k, kernel_cols, out, out_cols);
+                            continue;
+                        }
+                        for (int j = 0; j < out_cols; ++j)
+                        {
+                            float sum = out[j];
+                            for (int q = 0; q < kernel_cols; ++q)
+                                sum += in[stride * j + q] * k[q];
+                            out[j] = sum;
+                        }
+                    }
+                }
+            }
+
+            return outputs;
+        }
+
+        // A horizontal pass with `row` over every input row, then a vertical pass with `column`
+        Matrix correlate_separable(const MatrixView &input, const Matrix &column, const Matrix &row)
+        {
+            const int column_taps = column.cols, row_taps = row.cols;
+            int out_rows = input.rows - column_taps + 1;
+            int out_cols = input.cols - row_taps + 1;
+
+            Matrix horizontal(input.rows, out_cols, 0);
+            for (int i = 0; i < input.rows; ++i)
+                Simd::correlate_row(input[i], row[0], row_taps, horizontal[i], out_cols);
+
+            Matrix output(out_rows, out_cols, 0);
+            for (int i = 0; i < out_rows; ++i)
+            {
+                float *out = output[i];
+                for (int p = 0; p < column_taps; ++p)
+                    Simd::correlate_row(horizontal[i + p], column[0] + p, 1, out, out_cols);
+            }
+
+            return output;
+        }
+
+        // Floats in the patch matrix of one band of output rows (4 MB)
+        constexpr int GEMM_PATCH_BUDGET = 1 << 20;
+
+        // im2col: every output pixel becomes a column of its input patch,
+        // and the kernels, flattened into the rows of one matrix, multiply
+        // all the columns at once. Output rows are lowered a band at a time
+        // to keep the patch matrix in cache.
+        std::vector<Matrix> correlate_gemm(const MatrixView &input, const std::vector<MatrixView> &kernels, int stride)
+        {
+            const int kernel_rows = kernels[0].rows, kernel_cols = kernels[0].cols;
+            const int taps = kernel_rows * kernel_cols, count = kernels.size();
+            const int out_rows = (input.rows - kernel_rows) / stride + 1;
+            const int out_cols = (input.cols - kernel_cols) / stride + 1;
+            std::vector<Matrix> outputs(count, Matrix(out_rows, out_cols));
+
+            Matrix weights(count, taps);
+            for (int n = 0; n < count; n++)
+                for (int p = 0; p < kernel_rows; p++)
+                    std::copy(kernels[n][p], kernels[n][p] + kernel_cols, weights[n] + p * kernel_cols);
+
+            const int band = std::clamp(GEMM_PATCH_BUDGET / (taps * out_cols), 1, out_rows);
+            Matrix patches(taps, band * out_cols), product(count, band * out_cols);
+            for (int first = 0; first < out_rows; first += band)
+            {
+                const int rows = std::min(band, out_rows - first), pixels = rows * out_cols;
+                for (int p = 0; p < kernel_rows; p++)
+                    for (int q = 0; q < kernel_cols; q++)
+                    {
+                        float *patch_row = patches[p * kernel_cols + q];
+                        for (int i = 0; i < rows; i++)
+                        {
+                            const float *in = input[(first + i) * stride + p] + q;
+                            float *out = patch_row + i * out_cols;
+                            if (stride == 1)
+                                std::copy(in, in + out_cols, out);
+                            else
+                                for (int j = 0; j < out_cols; j++)
+                                    out[j] = in[j * stride];
+                        }
+                    }
+
+                gemm(count, pixels, taps, weights.data.data(), weights.stride, patches.data.data(), patches.stride, product.data.data(), product.stride);
+                for (int n = 0; n < count; n++)
+                    std::copy(product[n], product[n] + pixels, outputs[n][first]);
+            }
+
+            return outputs;
+        }
+
+        // Overlap-save: the input is cut into overlapping tiles of one FFT
+        // size. Each tile is multiplied in the frequency domain with the
+        // spectrum of the flipped kernel (a circular convolution) and only
+        // the part of the result that did not wrap around is kept. The
+        // spectrum of a tile is computed once for all kernels.
+        std::vector<Matrix> correlate_fft(const MatrixView &input, const std::vector<MatrixView> &kernels)
+        {
+            const int kernel_rows = kernels[0].rows, kernel_cols = kernels[0].cols;
+            const int out_rows = input.rows - kernel_rows + 1;
+            const int out_cols = input.cols - kernel_cols + 1;
+            std::vector<Matrix> outputs(kernels.size(), Matrix(out_rows, out_cols));
+
+            // Tiles a few times larger than the kernel keep the discarded
+            // overlap small; a small input is a single tile.
+            auto tile_size = [](int input_size, int kernel_size)
+            {
+                return FFT::good_size(std::min(input_size, std::max(4 * kernel_size, 256)));
+            };
+            const FFT::RealPlan2D plan(tile_size(input.rows, kernel_rows), tile_size(input.cols, kernel_cols));
+            const int step_rows = plan.rows() - kernel_rows + 1;
+            const int step_cols = plan.cols() - kernel_cols + 1;
+
+            std::vector<FFT::Spectrum> kernel_spectra;
+            for (const MatrixView &kernel : kernels)
+                kernel_spectra.push_back(plan.forward(kernel.to_matrix().flip()));
+
+            for (int tile_row = 0; tile_row < out_rows; tile_row += step_rows)
+            {
+                for (int tile_col = 0; tile_col < out_cols; tile_col += step_cols)
+                {
+                    int tile_rows = std::min(plan.rows(), input.rows - tile_row);
+                    int tile_cols = std::min(plan.cols(), input.cols - tile_col);
+                    const FFT::Spectrum spectrum = plan.forward(input.submatrix(tile_row, tile_row + tile_rows, tile_col, tile_col + tile_cols));
+
+                    for (size_t n = 0; n < kernels.size(); n++)
+                    {
+                        FFT::Spectrum product = spectrum;
+                        product.multiply(kernel_spectra[n]);
+                        Matrix circular = plan.inverse(product);
+
+                        // Output (i, j) of the tile is circular(i + kernel_rows - 1, j + kernel_cols - 1)
+                        int rows = std::min(step_rows, out_rows - tile_row);
+                        int cols = std::min(step_cols, out_cols - tile_col);
+                        for (int i = 0; i < rows; i++)
+                        {
+                            const float *src = circular[i + kernel_rows - 1] + kernel_cols - 1;
+                            std::copy(src, src + cols, outputs[n][tile_row + i] + tile_col);
+                        }
+                    }
+                }
+            }
+
+            return outputs;
+        }
+    }
+
+    void set_auto_planning(bool enabled)
+    {
+        planned_auto = enabled;
+    }
+
+    bool auto_planning()
+    {
+        return planned_auto;
+    }
+
+    Method choose_method(const MatrixView &kernel, int stride)
+    {
+        return choose_method(std::vector<MatrixView>{kernel}, stride);
+    }
+
+    Method choose_method(const std::vector<MatrixView> &kernels, int stride)
+    {
+        const MatrixView &first = kernels.at(0);
+        if (stride != 1 || first.rows == 1 || first.cols == 1)
+            return Method::DIRECT;
+        // The unrolled 3x3 pass is faster than two 1D passes, even for Sobel kernels
+        if (first.rows == 3 && first.cols == 3)
+            return Method::DIRECT;
+        Matrix column, row;
+        bool separable = true;
+        for (const MatrixView &kernel : kernels)
+            separable = separable && separate_kernel(kernel, column, row);
+        if (separable)
+            return Method::SEPARABLE;
+        const int area = first.rows * first.cols;
+        if (area >= FFT_MIN_KERNEL_AREA)
+            return Method::FFT;
+        if (area >= GEMM_MIN_KERNEL_AREA && (int)kernels.size() >= GEMM_MIN_KERNELS)
+            return Method::GEMM;
+        return Method::DIRECT;
+    }
+
+    Matrix correlate_valid(const MatrixView &input, const MatrixView &kernel, int stride, Method method)
+    {
+        return std::move(correlate_valid(input, std::vector<MatrixView>{kernel}, stride, method)[0]);
+    }
+
+    std::vector<Matrix> correlate_valid(const MatrixView &input, const std::vector<MatrixView> &kernels, int stride, Method method)
+    {
+        if (kernels.empty())
+            throw std::invalid_argument("At least one kernel is required.");
+        const int kernel_rows = kernels[0].rows, kernel_cols = kernels[0].cols;
+        for (const MatrixView &kernel : kernels)
+            if (kernel.rows != kernel_rows || kernel.cols != kernel_cols)
+                throw std::invalid_argument("All kernels must have the same size. Got " + std::to_string(kernel_rows) + "x" + std::to_string(kernel_cols) + " and " + std::to_string(kernel.rows) + "x" + std::to_string(kernel.cols) + ".");
+        if (kernel_rows > input.rows || kernel_cols > input.cols)
+            throw std::invalid_argument("Kernel dimensions cannot be larger than the input matrix dimensions.");
+        if (kernel_rows == 0 || kernel_cols == 0)
+            throw std::invalid_argument("Kernel cannot be empty.");
+        if (stride <= 0)
+            throw std::invalid_argument("Stride must be a positive integer.");
+
+        if (method == Method::AUTO)
+            method = choose_method(kernels, stride);
+        if (method != Method::DIRECT && method != Method::GEMM && stride != 1)
+            throw std::invalid_argument("The " + to_string(method) + " method needs a stride of 1. Got " + std::to_string(stride) + " instead.");
+
+        switch (method)
+        {
+        case Method::DIRECT:
+            return correlate_direct(input, kernels, stride);
+        case Method::SEPARABLE:
+        {
+            // Each pass is already cheap, the input is read once per kernel
+            std::vector<Matrix> outputs;
+            for (const MatrixView &kernel : kernels)
+            {
+                Matrix column, row;
+                if (!separate_kernel(kernel, column, row))
+                    throw std::invalid_argument("The separable method needs a rank-1 kernel.");
+                outputs.push_back(correlate_separable(input, column.transpose(), row));
+            }
+            return outputs;
+        }
+        case Method::FFT:
+            return correlate_fft(input, kernels);
+        case Method::GEMM:
+            return correlate_gemm(input, kernels, stride);
+        default:
+            throw std::invalid_argument("Invalid convolution method: " + std::to_string((int)method) + ".");
+        }
+    }
+
+    Matrix correlate_valid_separable(const MatrixView &input, const MatrixView &column, const MatrixView &row)
+    {
+        Matrix column_taps = taps(column, "column"), row_taps = taps(row, "row");
+        if (column_taps.cols > input.rows || row_taps.cols > input.cols)
+            throw std::invalid_argument("Kernel dimensions cannot be larger than the input matrix dimensions.");
+        return correlate_separable(input, column_taps, row_taps);
+    }
+
+    Matrix cross_correlate(const MatrixView &image, const MatrixView &kernel, BorderMode border, float value, Method method)
+    {
+        if (kernel.rows == 0 || kernel.cols == 0)
+            throw std::invalid_argument("Kernel cannot be empty.");
+        if (method == Method::AUTO && auto_planning())
+            return Planner::global().cross_correlate(image, kernel, border, value);
+
+        // The kernel center lands on every image pixel
+        int kernel_center_y = kernel.rows / 2;
+        int kernel_center_x = kernel.cols / 2;
+        Matrix padded = image.pad(kernel_center_y, kernel.rows - 1 - kernel_center_y,
+                                  kernel_center_x, kernel.cols - 1 - kernel_center_x, border, value);
+        return correlate_valid(padded, kernel, 1, method);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Matrix.hpp"
+
+namespace VisualAlgo::Convolution
+{
+    // Algorithms behind cross_correlate and convolve. They all compute the
+    // same result, up to rounding.
+    enum class Method
+    {
+        AUTO,      // SEPARABLE for rank-1 kernels above 3x3, FFT for large kernels, GEMM for large banks, DIRECT otherwise
+        DIRECT,    // one SIMD pass per kernel row, any stride; 3x3 and 5x5 kernels in a single unrolled pass
+        SEPARABLE, // a horizontal and a vertical 1D pass, rank-1 kernels and unit stride only
+        FFT,       // pointwise product of spectra, overlap-save over tiles, unit stride only
+        GEMM       // im2col: all kernels times a matrix of input patches in one blocked GEMM, any stride
+    };
+
+    std::string to_string(Method method);
+
+    // AUTO switches a non-separable kernel to FFT from this many taps on
+    // (29x29); below it direct correlation is faster, whatever the image size.
+    constexpr int FFT_MIN_KERNEL_AREA = 841;
+
+    // AUTO runs a bank of at least this many kernels of 9x9 taps or more
+    // (and below FFT_MIN_KERNEL_AREA) as one GEMM. Smaller banks and kernels
+    // do not pay back the copies into the patch matrix.
+    constexpr int GEMM_MIN_KERNELS = 48;
+    constexpr int GEMM_MIN_KERNEL_AREA = 81;
+
+    // With auto planning on, AUTO in the same-size cross-correlations and
+    // convolutions (here, in Matrix, MatrixView and FilterBank) runs the
+    // method Planner::global() measured for the shape instead of following
+    // the thresholds above. Off by default: the methods only agree up to
+    // rounding, and a measured plan depends on the machine and its load.
+    void set_auto_planning(bool enabled);
+    bool auto_planning();
+
+    Method choose_method(const MatrixView &kernel, int stride);
+    Method choose_method(const std::vector<MatrixView> &kernels, int stride); // SEPARABLE only if every kernel is
+
+    // Cross-correlation without padding: the output only covers positions
+    // where the whole kernel fits inside the input. Throws if `method`
+    // cannot handle the kernel or the stride.
+    Matrix correlate_valid(const MatrixView &input, const MatrixView &kernel, int stride = 1, Method method = Method::AUTO);
+    Matrix correlate_valid_separable(const MatrixView &input, const MatrixView &column, const MatrixView &row); // kernel = column * row
+
+    // Correlates one input with several kernels of the same size, one output
+    // per kernel. DIRECT uses every input row for all kernels while it is in
+    // cache, FFT transforms every input tile once for all kernels and GEMM
+    // lowers the input into patches once for all kernels.
+    std::vector<Matrix> correlate_valid(const MatrixView &input, const std::vector<MatrixView> &kernels, int stride = 1, Method method = Method::AUTO);
+
+    // Same-size cross-correlation, the image is extended with `border`
+    Matrix cross_correlate(const MatrixView &image, const MatrixView &kernel, BorderMode border = BorderMode::REFLECT_101, float value = 0, Method method = Method::AUTO);
+}
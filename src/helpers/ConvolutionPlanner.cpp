@@ -0,0 +1,172 @@
+#include "ConvolutionPlanner.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace VisualAlgo::Convolution
+{
+    namespace
+    {
+        const char *FILE_HEADER = "# image_rows image_cols kernel_rows kernel_cols kernels border separable method";
+
+        template <typename Enum>
+        bool parse(const std::string &name, std::initializer_list<Enum> values, Enum &result)
+        {
+            for (Enum value : values)
+                if (to_string(value) == name)
+                {
+                    result = value;
+                    return true;
+                }
+            return false;
+        }
+    }
+
+    Matrix Planner::cross_correlate(const MatrixView &image, const MatrixView &kernel, BorderMode border, float value, std::optional<bool> separable)
+    {
+        return std::move(cross_correlate(image, std::vector<MatrixView>{kernel}, border, value, separable)[0]);
+    }
+
+    std::vector<Matrix> Planner::cross_correlate(const MatrixView &image, const std::vector<MatrixView> &kernels, BorderMode border, float value, std::optional<bool> separable)
+    {
+        if (kernels.empty())
+            throw std::invalid_argument("At least one kernel is required.");
+        const MatrixView &first = kernels[0];
+        if (first.rows == 0 || first.cols == 0)
+            throw std::invalid_argument("Kernel cannot be empty.");
+
+        // The kernel center lands on every image pixel
+        Matrix padded = image.pad(first.rows / 2, first.rows - 1 - first.rows / 2,
+                                  first.cols / 2, first.cols - 1 - first.cols / 2, border, value);
+        PlanKey key = Planner::key(image, kernels, border, separable);
+        if (std::optional<Method> method = find(key))
+            return correlate_valid(padded, kernels, 1, *method);
+
+        // Measured without holding the lock: two threads meeting a new key
+        // at the same time both measure it, and the last one wins
+        std::vector<Matrix> best;
+        Method best_method = Method::DIRECT;
+        double best_time = 0;
+        for (Method method : {Method::DIRECT, Method::SEPARABLE, Method::FFT, Method::GEMM})
+        {
+            if (method == Method::SEPARABLE && !key.separable)
+                continue;
+            for (int run = 0; run < PLAN_RUNS; run++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                std::vector<Matrix> outputs = correlate_valid(padded, kernels, 1, method);
+                double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (best.empty() || time < best_time)
+                {
+                    best = std::move(outputs);
+                    best_method = method;
+                    best_time = time;
+                }
+            }
+        }
+        set(key, best_method);
+        return best;
+    }
+
+    PlanKey Planner::key(const MatrixView &image, const std::vector<MatrixView> &kernels, BorderMode border, std::optional<bool> separable)
+    {
+        if (kernels.empty())
+            throw std::invalid_argument("At least one kernel is required.");
+        if (!separable)
+        {
+            Matrix column, row;
+            separable = true;
+            for (const MatrixView &kernel : kernels)
+                separable = *separable && separate_kernel(kernel, column, row);
+        }
+        return PlanKey{image.rows, image.cols, kernels[0].rows, kernels[0].cols, (int)kernels.size(), border, *separable};
+    }
+
+    std::optional<Method> Planner::find(const PlanKey &key) const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto plan = this->plans.find(key);
+        if (plan == this->plans.end())
+            return std::nullopt;
+        return plan->second;
+    }
+
+    void Planner::set(const PlanKey &key, Method method)
+    {
+        if (method == Method::AUTO)
+            throw std::invalid_argument("A plan needs a concrete method, not auto.");
+        if (method == Method::SEPARABLE && !key.separable)
+            throw std::invalid_argument("The separable method needs rank-1 kernels.");
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->plans[key] = method;
+    }
+
+    int Planner::size() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->plans.size();
+    }
+
+    void Planner::clear()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->plans.clear();
+    }
+
+    void Planner::save(const std::string &filename) const
+    {
+        std::map<PlanKey, Method> plans;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            plans = this->plans;
+        }
+
+        std::ofstream file(filename);
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open file: " + filename + ".");
+        file << FILE_HEADER << "\n";
+        for (const auto &[key, method] : plans)
+            file << key.image_rows << " " << key.image_cols << " " << key.kernel_rows << " " << key.kernel_cols << " "
+                 << key.kernels << " " << VisualAlgo::to_string(key.border) << " " << key.separable << " " << to_string(method) << "\n";
+    }
+
+    void Planner::load(const std::string &filename)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open file: " + filename + ".");
+
+        // Parse the whole file before touching the plans
+        std::map<PlanKey, Method> loaded;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream fields(line);
+            PlanKey key;
+            std::string border, method_name, rest;
+            Method method;
+            if (!(fields >> key.image_rows >> key.image_cols >> key.kernel_rows >> key.kernel_cols >> key.kernels >> border >> key.separable >> method_name) || (fields >> rest) ||
+                !parse(border, {BorderMode::CONSTANT, BorderMode::REPLICATE, BorderMode::REFLECT, BorderMode::REFLECT_101, BorderMode::WRAP}, key.border) ||
+                !parse(method_name, {Method::DIRECT, Method::SEPARABLE, Method::FFT, Method::GEMM}, method) ||
+                (method == Method::SEPARABLE && !key.separable))
+                throw std::runtime_error("Invalid plan in " + filename + ": " + line);
+            loaded[key] = method;
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        for (const auto &[key, method] : loaded)
+            this->plans[key] = method;
+    }
+
+    Planner &Planner::global()
+    {
+        static Planner planner;
+        return planner;
+    }
+}
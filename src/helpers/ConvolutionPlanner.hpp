@@ -0,0 +1,64 @@
+#pragma once
+
+#include <compare>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "Convolution.hpp"
+
+namespace VisualAlgo::Convolution
+{
+    constexpr int PLAN_RUNS = 3;
+
+    // Everything the fastest method depends on, apart from the CPU
+    struct PlanKey
+    {
+        int image_rows, image_cols;
+        int kernel_rows, kernel_cols;
+        int kernels;     // size of the bank
+        BorderMode border;
+        bool separable;  // SEPARABLE is only a candidate for rank-1 kernels
+
+        auto operator<=>(const PlanKey &other) const = default;
+    };
+
+    // Picks the convolution method by measuring it. The first time a key is
+    // seen, every method that can handle it runs PLAN_RUNS times on the
+    // actual input, so that the first one does not pay alone for cold caches
+    // and page faults. The method with the fastest run is remembered and its
+    // output returned. Later calls with the same key run that method only. The plans can be saved to a
+    // file and loaded by the next process, so the measurements are paid
+    // once per machine. Safe to share between threads.
+    class Planner
+    {
+    public:
+        // Same-size cross-correlation, like Convolution::cross_correlate.
+        // `separable` is whether every kernel is rank 1, if the caller already
+        // knows it; otherwise separate_kernel tests every kernel on every call.
+        Matrix cross_correlate(const MatrixView &image, const MatrixView &kernel, BorderMode border = BorderMode::REFLECT_101, float value = 0, std::optional<bool> separable = std::nullopt);
+        std::vector<Matrix> cross_correlate(const MatrixView &image, const std::vector<MatrixView> &kernels, BorderMode border = BorderMode::REFLECT_101, float value = 0, std::optional<bool> separable = std::nullopt); // same-size kernels
+
+        static PlanKey key(const MatrixView &image, const std::vector<MatrixView> &kernels, BorderMode border, std::optional<bool> separable = std::nullopt);
+        std::optional<Method> find(const PlanKey &key) const;
+        void set(const PlanKey &key, Method method);
+        int size() const;
+        void clear();
+
+        // One plan per line in a text file. load adds to the plans already
+        // known, replacing those with the same key; it throws
+        // std::runtime_error if the file cannot be read or is malformed.
+        void save(const std::string &filename) const;
+        void load(const std::string &filename);
+
+        static Planner &global(); // used by AUTO once set_auto_planning(true) is called
+
+    private:
+        mutable std::mutex mutex;
+        std::map<PlanKey, Method> plans;
+    };
+}
@@ -0,0 +1,317 @@
+#include "FFT.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace VisualAlgo::FFT
+{
+    namespace
+    {
+        // std::complex's operator* checks for infinities and NaNs (C99 Annex G)
+        // through a library call, which dominates the butterflies
+        inline Complex multiply(const Complex &a, const Complex &b)
+        {
+            return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+        }
+    }
+
+    int good_size(int n)
+    {
+        if (n <= 1)
+            return 1;
+        for (int candidate = n;; candidate++)
+        {
+            int rest = candidate;
+            for (int factor : {2, 3, 5})
+                while (rest % factor == 0)
+                    rest /= factor;
+            if (rest == 1)
+                return candidate;
+        }
+    }
+
+    // Plan
+    Plan::Plan(int n)
+    {
+        if (n <= 0)
+            throw std::invalid_argument("FFT length must be positive. Got " + std::to_string(n) + " instead.");
+        this->n = n;
+
+        int rest = n;
+        while (rest % 4 == 0)
+        {
+            this->factors.push_back(4);
+            rest /= 4;
+        }
+        for (int factor = 2; rest > 1; factor++)
+            while (rest % factor == 0)
+            {
+                this->factors.push_back(factor);
+                rest /= factor;
+            }
+
+        this->roots.resize(n);
+        this->inverse_roots.resize(n);
+        for (int j = 0; j < n; j++)
+        {
+            double angle = -2 * M_PI * j / n;
+            this->roots[j] = Complex(std::cos(angle), std::sin(angle));
+            this->inverse_roots[j] = std::conj(this->roots[j]);
+        }
+    }
+
+    int Plan::size() const
+    {
+        return this->n;
+    }
+
+    void Plan::forward(Complex *data) const
+    {
+        std::vector<Complex> result(this->n);
+        transform(data, 1, result.data(), this->n, 0, false);
+        std::copy(result.begin(), result.end(), data);
+    }
+
+    void Plan::inverse(Complex *data) const
+    {
+        std::vector<Complex> result(this->n);
+        transform(data, 1, result.data(), this->n, 0, true);
+        const double scale = 1.0 / this->n;
+        for (int i = 0; i < this->n; i++)
+            data[i] = result[i] * scale;
+    }
+
+    // Decimation in time: transforms the `factor` interleaved subsequences of
+    // `in` into consecutive blocks of `out`, then combines them with one
+    // butterfly per output frequency.
+    void Plan::transform(const Complex *in, int in_stride, Complex *out, int length, int stage, bool inverse) const
+    {
+        if (length == 1)
+        {
+            out[0] = in[0];
+            return;
+        }
+
+        const int factor = this->factors[stage];
+        const int m = length / factor;
+        if (m == 1)
+        {
+            for (int r = 0; r < factor; r++)
+                out[r] = in[r * in_stride];
+        }
+        else
+        {
+            for (int r = 0; r < factor; r++)
+                transform(in + r * in_stride, in_stride * factor, out + r * m, m, stage + 1, inverse);
+        }
+
+        // root(j) = exp(-+2 pi i j / length)
+        const int step = this->n / length;
+        const Complex *roots = inverse ? this->inverse_roots.data() : this->roots.data();
+        auto root = [&](int j)
+        {
+            return roots[j * step];
+        };
+
+        if (factor == 2)
+        {
+            for (int k = 0; k < m; k++)
+            {
+                Complex a = out[k], b = multiply(out[k + m], root(k));
+                out[k] = a + b;
+                out[k + m] = a - b;
+            }
+            return;
+        }
+
+        if (factor == 4)
+        {
+            const Complex minus_i = inverse ? Complex(0, 1) : Complex(0, -1);
+            for (int k = 0; k < m; k++)
+            {
+                Complex a0 = out[k];
+                Complex a1 = multiply(out[k + m], root(k));
+                Complex a2 = multiply(out[k + 2 * m], root(2 * k));
+                Complex a3 = multiply(out[k + 3 * m], root(3 * k));
+                Complex b0 = a0 + a2, b1 = a0 - a2;
+                Complex b2 = a1 + a3, b3 = multiply(a1 - a3, minus_i);
+                out[k] = b0 + b2;
+                out[k + m] = b1 + b3;
+                out[k + 2 * m] = b0 - b2;
+                out[k + 3 * m] = b1 - b3;
+            }
+            return;
+        }
+
+        if (factor == 3)
+        {
+            // exp(-+2 pi i / 3) = -1/2 -+ i sqrt(3)/2
+            const double sin60 = inverse ? std::sqrt(0.75) : -std::sqrt(0.75);
+            for (int k = 0; k < m; k++)
+            {
+                Complex a0 = out[k];
+                Complex a1 = multiply(out[k + m], root(k));
+                Complex a2 = multiply(out[k + 2 * m], root(2 * k));
+                Complex sum = a1 + a2, difference = a1 - a2;
+                Complex half = a0 - 0.5 * sum;
+                Complex rotated(-sin60 * difference.imag(), sin60 * difference.real());
+                out[k] = a0 + sum;
+                out[k + m] = half + rotated;
+                out[k + 2 * m] = half - rotated;
+            }
+            return;
+        }
+
+        // Any other factor: a plain DFT of size `factor` per frequency
+        std::vector<Complex> twiddled(factor), combined(factor);
+        for (int k = 0; k < m; k++)
+        {
+            for (int r = 0; r < factor; r++)
+                twiddled[r] = multiply(out[r * m + k], root(r * k));
+            for (int q = 0; q < factor; q++)
+            {
+                Complex sum = 0;
+                for (int r = 0; r < factor; r++)
+                    sum += multiply(twiddled[r], root((r * q % factor) * m));
+                combined[q] = sum;
+            }
+            for (int q = 0; q < factor; q++)
+                out[q * m + k] = combined[q];
+        }
+    }
+
+    // Spectrum
+    int Spectrum::spectrum_cols() const
+    {
+        return this->cols / 2 + 1;
+    }
+
+    void Spectrum::multiply(const Spectrum &other)
+    {
+        if (other.rows != this->rows || other.cols != this->cols)
+            throw std::invalid_argument("Cannot multiply spectra of " + std::to_string(this->rows) + "x" + std::to_string(this->cols) + " and " + std::to_string(other.rows) + "x" + std::to_string(other.cols) + " images.");
+        for (size_t k = 0; k < this->data.size(); k++)
+            this->data[k] = FFT::multiply(this->data[k], other.data[k]);
+    }
+
+    Complex *Spectrum::operator[](int row)
+    {
+        return this->data.data() + static_cast<size_t>(row) * spectrum_cols();
+    }
+
+    const Complex *Spectrum::operator[](int row) const
+    {
+        return this->data.data() + static_cast<size_t>(row) * spectrum_cols();
+    }
+
+    // RealPlan2D
+    RealPlan2D::RealPlan2D(int rows, int cols) : row_plan(cols), col_plan(rows)
+    {
+    }
+
+    int RealPlan2D::rows() const
+    {
+        return this->col_plan.size();
+    }
+
+    int RealPlan2D::cols() const
+    {
+        return this->row_plan.size();
+    }
+
+    Spectrum RealPlan2D::forward(const MatrixView &input) const
+    {
+        const int rows = this->rows(), cols = this->cols();
+        if (input.rows > rows || input.cols > cols)
+            throw std::invalid_argument("Input of size " + std::to_string(input.rows) + "x" + std::to_string(input.cols) + " does not fit a " + std::to_string(rows) + "x" + std::to_string(cols) + " FFT plan.");
+
+        Spectrum spectrum{rows, cols, {}};
+        const int half = spectrum.spectrum_cols();
+        spectrum.data.assign(static_cast<size_t>(rows) * half, 0);
+
+        // Rows: the real rows a and b are transformed together as z = a + ib,
+        // then separated with A[k] = (Z[k] + conj(Z[-k])) / 2 and B[k] = (Z[k] - conj(Z[-k])) / 2i.
+        // Rows past the end of the input stay zero.
+        std::vector<Complex> z(cols);
+        for (int r = 0; r < input.rows; r += 2)
+        {
+            const float *a = input[r];
+            const float *b = r + 1 < input.rows ? input[r + 1] : nullptr;
+            std::fill(z.begin(), z.end(), 0);
+            for (int j = 0; j < input.cols; j++)
+                z[j] = Complex(a[j], b ? b[j] : 0);
+            this->row_plan.forward(z.data());
+
+            for (int k = 0; k < half; k++)
+            {
+                Complex zk = z[k], zn = std::conj(z[(cols - k) % cols]);
+                spectrum[r][k] = (zk + zn) * 0.5;
+                if (r + 1 < rows)
+                    spectrum[r + 1][k] = multiply(zk - zn, Complex(0, -0.5));
+            }
+        }
+
+        // Columns
+        std::vector<Complex> column(rows);
+        for (int k = 0; k < half; k++)
+        {
+            for (int r = 0; r < rows; r++)
+                column[r] = spectrum[r][k];
+            this->col_plan.forward(column.data());
+            for (int r = 0; r < rows; r++)
+                spectrum[r][k] = column[r];
+        }
+
+        return spectrum;
+    }
+
+    Matrix RealPlan2D::inverse(const Spectrum &spectrum) const
+    {
+        const int rows = this->rows(), cols = this->cols();
+        if (spectrum.rows != rows || spectrum.cols != cols)
+            throw std::invalid_argument("Spectrum of size " + std::to_string(spectrum.rows) + "x" + std::to_string(spectrum.cols) + " does not match a " + std::to_string(rows) + "x" + std::to_string(cols) + " FFT plan.");
+
+        // Columns
+        Spectrum rows_spectrum = spectrum;
+        const int half = rows_spectrum.spectrum_cols();
+        std::vector<Complex> column(rows);
+        for (int k = 0; k < half; k++)
+        {
+            for (int r = 0; r < rows; r++)
+                column[r] = rows_spectrum[r][k];
+            this->col_plan.inverse(column.data());
+            for (int r = 0; r < rows; r++)
+                rows_spectrum[r][k] = column[r];
+        }
+
+        // Rows, two at a time: z = a + ib has the spectrum A + iB
+        Matrix output(rows, cols);
+        std::vector<Complex> z(cols);
+        for (int r = 0; r < rows; r += 2)
+        {
+            const Complex *a = rows_spectrum[r];
+            const Complex *b = r + 1 < rows ? rows_spectrum[r + 1] : nullptr;
+            for (int k = 0; k < cols; k++)
+            {
+                Complex a_k = k < half ? a[k] : std::conj(a[cols - k]);
+                Complex b_k = b ? (k < half ? b[k] : std::conj(b[cols - k])) : 0;
+                z[k] = a_k + Complex(-b_k.imag(), b_k.real());
+            }
+            this->row_plan.inverse(z.data());
+
+            float *out_a = output[r];
+            for (int j = 0; j < cols; j++)
+                out_a[j] = static_cast<float>(z[j].real());
+            if (b)
+            {
+                float *out_b = output[r + 1];
+                for (int j = 0; j < cols; j++)
+                    out_b[j] = static_cast<float>(z[j].imag());
+            }
+        }
+
+        return output;
+    }
+}
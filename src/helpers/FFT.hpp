@@ -0,0 +1,65 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+
+#include "Matrix.hpp"
+
+namespace VisualAlgo::FFT
+{
+    using Complex = std::complex<double>;
+
+    // Smallest n' >= n of the form 2^a 3^b 5^c, which the plans below transform fastest
+    int good_size(int n);
+
+    // Complex discrete Fourier transform of a fixed length. Any length works:
+    // the length is split into radix-4, 2 and 3 butterflies, plus a plain DFT
+    // stage for 5 and any larger prime factor. Twiddle factors are computed once,
+    // so a plan is meant to be reused. All methods are const and thread-safe.
+    class Plan
+    {
+    public:
+        explicit Plan(int n);
+
+        int size() const;
+        void forward(Complex *data) const; // in place, X[k] = sum_j x[j] exp(-2 pi i jk / n)
+        void inverse(Complex *data) const; // in place, scaled by 1 / n so that inverse(forward(x)) == x
+
+    private:
+        int n;
+        std::vector<int> factors;           // radices, first stage first
+        std::vector<Complex> roots;         // roots[j] = exp(-2 pi i j / n)
+        std::vector<Complex> inverse_roots; // their conjugates
+
+        void transform(const Complex *in, int in_stride, Complex *out, int length, int stage, bool inverse) const;
+    };
+
+    // Spectrum of a real rows x cols image. A real signal has a Hermitian
+    // spectrum, so only the cols / 2 + 1 non-redundant columns are stored.
+    struct Spectrum
+    {
+        int rows, cols;            // size of the real image
+        std::vector<Complex> data; // rows x (cols / 2 + 1), row-major
+
+        int spectrum_cols() const;
+        void multiply(const Spectrum &other); // pointwise, the spectrum of the circular convolution of both images
+        Complex *operator[](int row);
+        const Complex *operator[](int row) const;
+    };
+
+    // 2D real-to-complex transform of a fixed size. Rows are transformed two
+    // at a time, packed as the real and imaginary parts of one complex row.
+    class RealPlan2D
+    {
+    public:
+        RealPlan2D(int rows, int cols);
+
+        int rows() const;
+        int cols() const;
+        Spectrum forward(const MatrixView &input) const; // input may be smaller than the plan, it is zero-padded
+        Matrix inverse(const Spectrum &spectrum) const;  // scaled so that inverse(forward(x)) == x
+
+    private:
+        Plan row_plan, col_plan;
+    };
+}
@@ -0,0 +1,84 @@
+#include "FilterBank.hpp"
+#include "ConvolutionPlanner.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace VisualAlgo
+{
+    // Constructors
+    FilterBank::FilterBank()
+    {
+    }
+
+    FilterBank::FilterBank(std::vector<Matrix> kernels, Convolution::Method method) : method(method)
+    {
+        for (const Matrix &kernel : kernels)
+            add(kernel);
+    }
+
+    void FilterBank::add(const MatrixView &kernel)
+    {
+        if (kernel.rows == 0 || kernel.cols == 0)
+            throw std::invalid_argument("Kernel cannot be empty.");
+        if (!this->kernels.empty() && (kernel.rows != this->kernels[0].rows || kernel.cols != this->kernels[0].cols))
+            throw std::invalid_argument("All kernels of a filter bank must have the same size. Expected " + std::to_string(this->kernels[0].rows) + "x" + std::to_string(this->kernels[0].cols) + ", got " + std::to_string(kernel.rows) + "x" + std::to_string(kernel.cols) + ".");
+        Matrix column, row;
+        this->separable = this->separable && separate_kernel(kernel, column, row);
+        this->kernels.push_back(kernel.to_matrix());
+    }
+
+    int FilterBank::size() const
+    {
+        return this->kernels.size();
+    }
+
+    // Image operations
+    std::vector<Matrix> FilterBank::cross_correlate(const MatrixView &input, int padding, int stride, BorderMode border, float value) const
+    {
+        if (padding < 0)
+            throw std::invalid_argument("Padding cannot be negative.");
+        return correlate(input, padding, padding, padding, padding, stride, border, value);
+    }
+
+    std::vector<Matrix> FilterBank::cross_correlate(const MatrixView &input, BorderMode border, float value) const
+    {
+        if (this->method == Convolution::Method::AUTO && Convolution::auto_planning() && !this->kernels.empty())
+            return Convolution::Planner::global().cross_correlate(input, std::vector<MatrixView>(this->kernels.begin(), this->kernels.end()), border, value, this->separable);
+        int kernel_rows = size() ? this->kernels[0].rows : 0, kernel_cols = size() ? this->kernels[0].cols : 0;
+        return correlate(input, kernel_rows / 2, kernel_rows - 1 - kernel_rows / 2,
+                         kernel_cols / 2, kernel_cols - 1 - kernel_cols / 2, 1, border, value);
+    }
+
+    std::vector<Matrix> FilterBank::convolve(const MatrixView &input, int padding, int stride, BorderMode border, float value) const
+    {
+        return flipped().cross_correlate(input, padding, stride, border, value);
+    }
+
+    std::vector<Matrix> FilterBank::convolve(const MatrixView &input, BorderMode border, float value) const
+    {
+        return flipped().cross_correlate(input, border, value);
+    }
+
+    // Private
+    std::vector<Matrix> FilterBank::correlate(const MatrixView &input, int top, int bottom, int left, int right, int stride, BorderMode border, float value) const
+    {
+        if (this->kernels.empty())
+            throw std::invalid_argument("Filter bank has no kernels.");
+        std::vector<MatrixView> kernels(this->kernels.begin(), this->kernels.end());
+        if (top == 0 && bottom == 0 && left == 0 && right == 0)
+            return Convolution::correlate_valid(input, kernels, stride, this->method);
+        Matrix padded = input.pad(top, bottom, left, right, border, value);
+        return Convolution::correlate_valid(padded, kernels, stride, this->method);
+    }
+
+    FilterBank FilterBank::flipped() const
+    {
+        // Flipping keeps the rank, the separability is not tested again
+        FilterBank bank = *this;
+        for (Matrix &kernel : bank.kernels)
+            kernel = kernel.flip();
+        return bank;
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "Convolution.hpp"
+
+namespace VisualAlgo
+{
+    // Kernels of the same size applied together to one input, e.g. the
+    // orientations of an oriented filter. The input is padded once and read
+    // once for the whole bank (see Convolution::correlate_valid), instead of
+    // once per kernel. Kernels are meant to be added through add(), which
+    // keeps track of their separability for Convolution::auto_planning().
+    struct FilterBank
+    {
+        // Attributes
+        std::vector<Matrix> kernels;
+        Convolution::Method method = Convolution::Method::AUTO;
+
+        // Constructors
+        FilterBank();
+        explicit FilterBank(std::vector<Matrix> kernels, Convolution::Method method = Convolution::Method::AUTO);
+
+        void add(const MatrixView &kernel); // must match the size of the other kernels
+        int size() const;
+
+        // One output per kernel, in order. Same arguments as the Matrix functions.
+        std::vector<Matrix> cross_correlate(const MatrixView &input, int padding, int stride, BorderMode border = BorderMode::CONSTANT, float value = 0) const;
+        std::vector<Matrix> cross_correlate(const MatrixView &input, BorderMode border = BorderMode::REFLECT_101, float value = 0) const; // keeps the same size
+        std::vector<Matrix> convolve(const MatrixView &input, int padding, int stride, BorderMode border = BorderMode::CONSTANT, float value = 0) const;
+        std::vector<Matrix> convolve(const MatrixView &input, BorderMode border = BorderMode::REFLECT_101, float value = 0) const; // keeps the same size
+
+    private:
+        bool separable = true; // every kernel is rank 1, tested once by add() for the planner
+        std::vector<Matrix> correlate(const MatrixView &input, int top, int bottom, int left, int right, int stride, BorderMode border, float value) const;
+        FilterBank flipped() const;
+    };
+}
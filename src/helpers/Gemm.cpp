@@ -0,0 +1,226 @@
+#include "Gemm.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define VISUALALGO_GEMM_X86 1
+#else
+#define VISUALALGO_GEMM_X86 0
+#endif
+
+namespace VisualAlgo
+{
+    namespace
+    {
+        // Tile of C held in registers by the micro-kernel
+        constexpr int MR = 6;
+        constexpr int NR = 16;
+
+        // Cache blocking: an MC x KC block of A stays in L2 and a KC x NC
+        // panel of B in L3 while the micro-kernel sweeps over them.
+        constexpr int MC = 96;
+        constexpr int KC = 256;
+        constexpr int NC = 2048;
+
+        // Below this many multiply-adds, starting threads costs more than it saves
+        constexpr double MIN_FLOPS_PER_THREAD = 1 << 20;
+
+        // Below this many multiply-adds, packing costs more than it saves
+        constexpr double MIN_FLOPS_PACKED = 1 << 12;
+
+        typedef void (*MicroKernel)(int kc, const float *packed_a, const float *packed_b, float *c, int ldc, int mr, int nr);
+
+        namespace scalar
+        {
+            static void micro_kernel(int kc, const float *packed_a, const float *packed_b, float *c, int ldc, int mr, int nr)
+            {
+                float acc[MR][NR] = {};
+                for (int p = 0; p < kc; p++)
+                    for (int r = 0; r < MR; r++)
+                        for (int j = 0; j < NR; j++)
+                            acc[r][j] += packed_a[p * MR + r] * packed_b[p * NR + j];
+                for (int r = 0; r < mr; r++)
+                    for (int j = 0; j < nr; j++)
+                        c[static_cast<size_t>(r) * ldc + j] += acc[r][j];
+            }
+        }
+
+#if VISUALALGO_GEMM_X86
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+        namespace sse4
+        {
+#include "GemmKernel.inl"
+        }
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+        namespace avx2
+        {
+#include "GemmKernel.inl"
+        }
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+        namespace avx512
+        {
+#include "GemmKernel.inl"
+        }
+#pragma GCC pop_options
+
+#pragma GCC diagnostic pop
+#endif
+
+        MicroKernel micro_kernel_for(Simd::Isa isa)
+        {
+            switch (isa)
+            {
+#if VISUALALGO_GEMM_X86
+            case Simd::Isa::SSE4:
+                return sse4::micro_kernel;
+            case Simd::Isa::AVX2:
+                return avx2::micro_kernel;
+            case Simd::Isa::AVX512:
+                return avx512::micro_kernel;
+#endif
+            default:
+                return scalar::micro_kernel;
+            }
+        }
+
+        // Copies the mc x kc block of A starting at `a` into strips of MR rows,
+        // stored column by column. Missing rows of the last strip are zero.
+        void pack_a(int mc, int kc, const float *a, int lda, float *packed)
+        {
+            for (int i = 0; i < mc; i += MR)
+            {
+                const int mr = std::min(MR, mc - i);
+                for (int p = 0; p < kc; p++)
+                {
+                    for (int r = 0; r < mr; r++)
+                        packed[p * MR + r] = a[static_cast<size_t>(i + r) * lda + p];
+                    for (int r = mr; r < MR; r++)
+                        packed[p * MR + r] = 0;
+                }
+                packed += static_cast<size_t>(kc) * MR;
+            }
+        }
+
+        // Copies the kc x nc panel of B starting at `b` into strips of NR
+        // columns, stored row by row. Missing columns of the last strip are zero.
+        void pack_b(int kc, int nc, const float *b, int ldb, float *packed)
+        {
+            for (int j = 0; j < nc; j += NR)
+            {
+                const int nr = std::min(NR, nc - j);
+                for (int p = 0; p < kc; p++)
+                {
+                    const float *row = b + static_cast<size_t>(p) * ldb + j;
+                    std::memcpy(packed + p * NR, row, nr * sizeof(float));
+                    std::fill(packed + p * NR + nr, packed + (p + 1) * NR, 0.0f);
+                }
+                packed += static_cast<size_t>(kc) * NR;
+            }
+        }
+
+        // C += A * B for one row panel of C, single-threaded
+        void gemm_panel(int m, int n, int k, const float *a, int lda, const float *b, int ldb, float *c, int ldc, MicroKernel kernel)
+        {
+            std::vector<float> packed_a(static_cast<size_t>(MC) * KC);
+            std::vector<float> packed_b(static_cast<size_t>(KC) * ((std::min(NC, n) + NR - 1) / NR * NR));
+
+            for (int jc = 0; jc < n; jc += NC)
+            {
+                const int nc = std::min(NC, n - jc);
+                for (int pc = 0; pc < k; pc += KC)
+                {
+                    const int kc = std::min(KC, k - pc);
+                    pack_b(kc, nc, b + static_cast<size_t>(pc) * ldb + jc, ldb, packed_b.data());
+                    for (int ic = 0; ic < m; ic += MC)
+                    {
+                        const int mc = std::min(MC, m - ic);
+                        pack_a(mc, kc, a + static_cast<size_t>(ic) * lda + pc, lda, packed_a.data());
+                        for (int jr = 0; jr < nc; jr += NR)
+                        {
+                            const float *strip_b = packed_b.data() + static_cast<size_t>(jr) * kc;
+                            for (int ir = 0; ir < mc; ir += MR)
+                            {
+                                const float *strip_a = packed_a.data() + static_cast<size_t>(ir) * kc;
+                                float *tile = c + static_cast<size_t>(ic + ir) * ldc + jc + jr;
+                                kernel(kc, strip_a, strip_b, tile, ldc, std::min(MR, mc - ir), std::min(NR, nc - jr));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void gemm(int m, int n, int k, const float *a, int lda, const float *b, int ldb, float *c, int ldc, bool accumulate, int threads)
+    {
+        if (m < 0 || n < 0 || k < 0)
+            throw std::invalid_argument("Matrix dimensions must be positive. Got " + std::to_string(m) + "x" + std::to_string(k) + " times " + std::to_string(k) + "x" + std::to_string(n) + " instead.");
+        if (lda < k || ldb < n || ldc < n)
+            throw std::invalid_argument("Row strides must be at least the number of columns.");
+        if (threads < 0)
+            throw std::invalid_argument("Number of threads must be non-negative. Got " + std::to_string(threads) + " instead.");
+
+        if (!accumulate)
+            for (int i = 0; i < m; i++)
+                std::fill(c + static_cast<size_t>(i) * ldc, c + static_cast<size_t>(i) * ldc + n, 0.0f);
+        if (m == 0 || n == 0 || k == 0)
+            return;
+
+        if (static_cast<double>(m) * n * k < MIN_FLOPS_PACKED)
+        {
+            for (int i = 0; i < m; i++)
+            {
+                float *out = c + static_cast<size_t>(i) * ldc;
+                for (int p = 0; p < k; p++)
+                {
+                    const float value = a[static_cast<size_t>(i) * lda + p];
+                    const float *row = b + static_cast<size_t>(p) * ldb;
+                    for (int j = 0; j < n; j++)
+                        out[j] += value * row[j];
+                }
+            }
+            return;
+        }
+
+        MicroKernel kernel = micro_kernel_for(Simd::active_isa());
+
+        // Each task gets a panel of whole MR-row strips. The panels run on the
+        // shared pool, so a gemm called from a pool task does not start more
+        // threads than there are cores.
+        const int strips = (m + MR - 1) / MR;
+        if (threads == 0)
+        {
+            const double flops = static_cast<double>(m) * n * k;
+            threads = std::max(1, static_cast<int>(std::min<double>(ThreadPool::global().size(), flops / MIN_FLOPS_PER_THREAD)));
+        }
+        threads = std::min(threads, strips);
+
+        if (threads <= 1)
+        {
+            gemm_panel(m, n, k, a, lda, b, ldb, c, ldc, kernel);
+            return;
+        }
+
+        ThreadPool::global().parallel_for(threads, [&](int t)
+                                          {
+            const int row = strips * t / threads * MR;
+            const int rows = std::min(m - row, (strips * (t + 1) / threads - strips * t / threads) * MR);
+            gemm_panel(rows, n, k, a + static_cast<size_t>(row) * lda, lda, b, ldb, c + static_cast<size_t>(row) * ldc, ldc, kernel); });
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace VisualAlgo
+{
+    // General matrix multiply on row-major buffers: C = A * B, or C += A * B
+    // when `accumulate` is set. A is m x k, B is k x n and C is m x n; lda, ldb
+    // and ldc are the row strides (in elements) of the three buffers, so any of
+    // them can be a region of a larger matrix. C must not overlap A or B.
+    //
+    // The operands are packed into cache-sized blocks and multiplied by a
+    // register-blocked SIMD micro-kernel picked at runtime (see Simd.hpp).
+    // Large products are split into `threads` row panels of C, computed on
+    // ThreadPool::global(); 0 picks a number based on the size of the product
+    // and the size of the pool.
+    void gemm(int m, int n, int k,
+              const float *a, int lda,
+              const float *b, int ldb,
+              float *c, int ldc,
+              bool accumulate = false, int threads = 0);
+}
@@ -0,0 +1,40 @@
+// Register-blocked GEMM micro-kernel written with GCC vector extensions.
+//
+// Gemm.cpp includes this file once per instruction set, inside its own
+// namespace and a `#pragma GCC target(...)` region. A row of the MR x NR tile
+// is one 64-byte vector, which GCC splits into as many registers as the
+// target needs (one zmm, two ymm or four xmm).
+
+typedef float vrow __attribute__((vector_size(NR * sizeof(float))));
+
+// C[0:mr, 0:nr] += packed_a * packed_b, where packed_a holds kc columns of MR
+// rows and packed_b holds kc rows of NR columns (see pack_a and pack_b).
+static void micro_kernel(int kc, const float *packed_a, const float *packed_b, float *c, int ldc, int mr, int nr)
+{
+    vrow acc[MR] = {};
+    for (int p = 0; p < kc; p++)
+    {
+        vrow b;
+        std::memcpy(&b, packed_b + p * NR, sizeof(b));
+        const float *a = packed_a + p * MR;
+        for (int r = 0; r < MR; r++)
+            acc[r] += a[r] * b;
+    }
+
+    for (int r = 0; r < mr; r++)
+    {
+        float *row = c + static_cast<size_t>(r) * ldc;
+        if (nr == NR)
+        {
+            vrow current;
+            std::memcpy(&current, row, sizeof(current));
+            current += acc[r];
+            std::memcpy(row, &current, sizeof(current));
+        }
+        else
+        {
+            for (int j = 0; j < nr; j++)
+                row[j] += acc[r][j];
+        }
+    }
+}
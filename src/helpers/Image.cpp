@@ -0,0 +1,304 @@
+#include "Image.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace VisualAlgo
+{
+    std::string to_string(ChannelLayout layout)
+    {
+        switch (layout)
+        {
+        case ChannelLayout::PLANAR:
+            return "planar";
+        case ChannelLayout::INTERLEAVED:
+            return "interleaved";
+        default:
+            return "unknown";
+        }
+    }
+
+    // ChannelView
+    const float ChannelView::get(int row, int col) const
+    {
+        if (row < 0 || row >= this->rows || col < 0 || col >= this->cols)
+            throw std::out_of_range("Matrix index (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+        return this->data[static_cast<size_t>(row) * this->row_stride + static_cast<size_t>(col) * this->pixel_stride];
+    }
+
+    Matrix ChannelView::to_matrix() const
+    {
+        Matrix result(this->rows, this->cols);
+        for (int i = 0; i < this->rows; i++)
+        {
+            const float *src = this->data + static_cast<size_t>(i) * this->row_stride;
+            float *dst = result[i];
+            for (int j = 0; j < this->cols; j++)
+                dst[j] = src[static_cast<size_t>(j) * this->pixel_stride];
+        }
+        return result;
+    }
+
+    // Constructors
+    Image::Image()
+    {
+        this->rows = 0;
+        this->cols = 0;
+        this->channels = 0;
+        this->layout = ChannelLayout::PLANAR;
+    }
+
+    Image::Image(int rows, int cols, int channels, ChannelLayout layout, float value)
+    {
+        if (rows < 0 || cols < 0 || channels < 0)
+            throw std::invalid_argument("Image dimensions must be positive");
+        this->rows = rows;
+        this->cols = cols;
+        this->channels = channels;
+        this->layout = layout;
+        this->data = std::vector<float>(static_cast<size_t>(rows) * cols * channels, value);
+    }
+
+    Image::Image(const Matrix &gray) : Image(gray.rows, gray.cols, 1)
+    {
+        for (int i = 0; i < gray.rows; i++)
+            std::copy(gray[i], gray[i] + gray.cols, this->data.begin() + static_cast<size_t>(i) * gray.cols);
+    }
+
+    Image Image::from_channels(const std::vector<Matrix> &channels, ChannelLayout layout)
+    {
+        if (channels.empty())
+            throw std::invalid_argument("An image needs at least one channel");
+        for (const Matrix &channel : channels)
+            if (channel.rows != channels[0].rows || channel.cols != channels[0].cols)
+                throw std::invalid_argument("All channels must have the same dimensions. Got " + std::to_string(channels[0].rows) + "x" + std::to_string(channels[0].cols) + " and " + std::to_string(channel.rows) + "x" + std::to_string(channel.cols) + " instead.");
+
+        Image result(channels[0].rows, channels[0].cols, channels.size(), layout);
+        for (int c = 0; c < result.channels; c++)
+            for (int i = 0; i < result.rows; i++)
+            {
+                const float *src = channels[c][i];
+                for (int j = 0; j < result.cols; j++)
+                    result.data[result.index(i, j, c)] = src[j];
+            }
+        return result;
+    }
+
+    // Accessors
+    void Image::set(int row, int col, int channel, float value)
+    {
+        check_index(row, col, channel);
+        this->data[index(row, col, channel)] = value;
+    }
+
+    const float Image::get(int row, int col, int channel) const
+    {
+        check_index(row, col, channel);
+        return this->data[index(row, col, channel)];
+    }
+
+    ChannelView Image::channel(int channel) const
+    {
+        check_channel(channel);
+        if (this->layout == ChannelLayout::PLANAR)
+            return ChannelView{this->data.data() + index(0, 0, channel), this->rows, this->cols, this->cols, 1};
+        return ChannelView{this->data.data() + channel, this->rows, this->cols, this->cols * this->channels, this->channels};
+    }
+
+    MatrixView Image::plane(int channel) const
+    {
+        check_channel(channel);
+        if (this->layout != ChannelLayout::PLANAR)
+            throw std::invalid_argument("Only the channels of a planar image can be viewed as a MatrixView. Got an " + to_string(this->layout) + " image instead.");
+        return MatrixView(this->data.data() + index(0, 0, channel), this->rows, this->cols, this->cols);
+    }
+
+    Matrix Image::channel_matrix(int channel) const
+    {
+        return this->channel(channel).to_matrix();
+    }
+
+    // Layout
+    Image Image::to_layout(ChannelLayout layout) const
+    {
+        if (layout == this->layout)
+            return *this;
+        Image result(this->rows, this->cols, this->channels, layout);
+        for (int c = 0; c < this->channels; c++)
+            for (int i = 0; i < this->rows; i++)
+                for (int j = 0; j < this->cols; j++)
+                    result.data[result.index(i, j, c)] = this->data[index(i, j, c)];
+        return result;
+    }
+
+    // Color conversions
+    Matrix Image::to_gray() const
+    {
+        if (this->channels == 1)
+            return this->channel_matrix(0);
+        if (this->channels != 3)
+            throw std::invalid_argument("Color conversion needs 3 channels. Got " + std::to_string(this->channels) + " instead.");
+
+        // Only the luma row of the color matrix, straight into the result
+        const float wr = 0.2126f, wg = 0.7152f, wb = 0.0722f;
+        Matrix result(this->rows, this->cols);
+        if (this->layout == ChannelLayout::PLANAR)
+        {
+            const size_t n = static_cast<size_t>(this->rows) * this->cols;
+            const float *in = this->data.data();
+            Simd::combine3(in, in + n, in + 2 * n, result.data.data(), n, wr, wg, wb, 0);
+            return result;
+        }
+
+        // Deinterleave one row at a time
+        std::vector<float> in(3 * static_cast<size_t>(this->cols));
+        const size_t n = this->cols;
+        for (int i = 0; i < this->rows; i++)
+        {
+            const float *src = this->data.data() + index(i, 0, 0);
+            for (size_t j = 0; j < n; j++)
+                for (int c = 0; c < 3; c++)
+                    in[c * n + j] = src[3 * j + c];
+            Simd::combine3(in.data(), in.data() + n, in.data() + 2 * n, result[i], n, wr, wg, wb, 0);
+        }
+        return result;
+    }
+
+    Image Image::rgb_to_ycbcr() const
+    {
+        const float coefficients[3][3] = {{0.2126f, 0.7152f, 0.0722f},
+                                          {-0.114572f, -0.385428f, 0.5f},
+                                          {0.5f, -0.454153f, -0.045847f}};
+        const float offsets[3] = {0, 128, 128};
+        return apply_color_matrix(coefficients, offsets);
+    }
+
+    Image Image::ycbcr_to_rgb() const
+    {
+        const float coefficients[3][3] = {{1, 0, 1.5748f},
+                                          {1, -0.187324f, -0.468124f},
+                                          {1, 1.8556f, 0}};
+        const float offsets[3] = {-1.5748f * 128, (0.187324f + 0.468124f) * 128, -1.8556f * 128};
+        return apply_color_matrix(coefficients, offsets);
+    }
+
+    // Image operations
+    void Image::load(const std::string &filename, ChannelLayout layout)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open file: " + filename + ".");
+        }
+
+        std::string header;
+        file >> header;
+        if (header != "P6" && header != "P5")
+        {
+            throw std::runtime_error("Can only handle PPM (P6) and PGM (P5) formats. Got: " + header + " instead.");
+        }
+
+        int rows, cols, max_value;
+        file >> cols >> rows >> max_value;
+        file.get(); // consume newline
+
+        *this = Image(rows, cols, header == "P6" ? 3 : 1, layout);
+
+        std::vector<unsigned char> scanline(static_cast<size_t>(cols) * this->channels);
+        for (int i = 0; i < rows; ++i)
+        {
+            file.read(reinterpret_cast<char *>(scanline.data()), scanline.size());
+            for (int j = 0; j < cols; ++j)
+                for (int c = 0; c < this->channels; ++c)
+                    this->data[index(i, j, c)] = scanline[static_cast<size_t>(j) * this->channels + c];
+        }
+    }
+
+    void Image::save(const std::string &filename) const
+    {
+        if (this->channels != 1 && this->channels != 3)
+            throw std::runtime_error("Can only save images with 1 or 3 channels. Got " + std::to_string(this->channels) + " instead.");
+        for (float value : this->data)
+            if (value > 255 || value < 0)
+                throw std::runtime_error("Image values must be between 0 and 255. Please consider normalizing.");
+
+        std::ofstream file(filename, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open file: " + filename + ".");
+        }
+
+        file << (this->channels == 3 ? "P6\n" : "P5\n");
+        file << this->cols << " " << this->rows << "\n";
+        file << 255 << "\n";
+
+        std::vector<unsigned char> scanline(static_cast<size_t>(this->cols) * this->channels);
+        for (int i = 0; i < this->rows; ++i)
+        {
+            for (int j = 0; j < this->cols; ++j)
+                for (int c = 0; c < this->channels; ++c)
+                    scanline[static_cast<size_t>(j) * this->channels + c] = static_cast<unsigned char>(this->data[index(i, j, c)]);
+            file.write(reinterpret_cast<char *>(scanline.data()), scanline.size());
+        }
+    }
+
+    // Private
+    size_t Image::index(int row, int col, int channel) const
+    {
+        if (this->layout == ChannelLayout::PLANAR)
+            return (static_cast<size_t>(channel) * this->rows + row) * this->cols + col;
+        return (static_cast<size_t>(row) * this->cols + col) * this->channels + channel;
+    }
+
+    void Image::check_index(int row, int col, int channel) const
+    {
+        if (row < 0 || row >= this->rows || col < 0 || col >= this->cols)
+            throw std::out_of_range("Image index (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+        check_channel(channel);
+    }
+
+    void Image::check_channel(int channel) const
+    {
+        if (channel < 0 || channel >= this->channels)
+            throw std::out_of_range("Image channel " + std::to_string(channel) + " out of range");
+    }
+
+    // out[k] = sum_c coefficients[k][c] * in[c] + offsets[k], for images with 3 channels
+    Image Image::apply_color_matrix(const float coefficients[3][3], const float offsets[3]) const
+    {
+        if (this->channels != 3)
+            throw std::invalid_argument("Color conversion needs 3 channels. Got " + std::to_string(this->channels) + " instead.");
+
+        Image result(this->rows, this->cols, 3, this->layout);
+        if (this->layout == ChannelLayout::PLANAR)
+        {
+            // Whole planes at once
+            const size_t n = static_cast<size_t>(this->rows) * this->cols;
+            const float *in = this->data.data();
+            for (int k = 0; k < 3; k++)
+                Simd::combine3(in, in + n, in + 2 * n, result.data.data() + k * n, n, coefficients[k][0], coefficients[k][1], coefficients[k][2], offsets[k]);
+            return result;
+        }
+
+        // Deinterleave one row at a time, convert it as planes and interleave it back
+        std::vector<float> in(3 * static_cast<size_t>(this->cols)), out(3 * static_cast<size_t>(this->cols));
+        const size_t n = this->cols;
+        for (int i = 0; i < this->rows; i++)
+        {
+            const float *src = this->data.data() + index(i, 0, 0);
+            for (size_t j = 0; j < n; j++)
+                for (int c = 0; c < 3; c++)
+                    in[c * n + j] = src[3 * j + c];
+            for (int k = 0; k < 3; k++)
+                Simd::combine3(in.data(), in.data() + n, in.data() + 2 * n, out.data() + k * n, n, coefficients[k][0], coefficients[k][1], coefficients[k][2], offsets[k]);
+            float *dst = result.data.data() + result.index(i, 0, 0);
+            for (size_t j = 0; j < n; j++)
+                for (int c = 0; c < 3; c++)
+                    dst[3 * j + c] = out[c * n + j];
+        }
+        return result;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+namespace VisualAlgo
+{
+    // How the channels of an Image are arranged in its buffer
+    enum class ChannelLayout
+    {
+        PLANAR,     // one full plane per channel: RRR...GGG...BBB...
+        INTERLEAVED // channels of a pixel next to each other: RGBRGBRGB...
+    };
+
+    std::string to_string(ChannelLayout layout);
+
+    // Non-owning, read-only view of one channel of an Image. Unlike a
+    // MatrixView it can step over the other channels of an interleaved image.
+    struct ChannelView
+    {
+        const float *data;
+        int rows, cols;
+        int row_stride;   // distance (in elements) between the starts of two consecutive rows
+        int pixel_stride; // distance (in elements) between two consecutive pixels of a row
+
+        const float get(int row, int col) const;
+        Matrix to_matrix() const;
+    };
+
+    // Multi-channel float image, e.g. RGB with values in [0, 255].
+    struct Image
+    {
+        // Attributes
+        int rows, cols, channels;
+        ChannelLayout layout;
+        std::vector<float> data;
+
+        // Constructors
+        Image();
+        Image(int rows, int cols, int channels, ChannelLayout layout = ChannelLayout::PLANAR, float value = 0);
+        explicit Image(const Matrix &gray); // single planar channel
+        static Image from_channels(const std::vector<Matrix> &channels, ChannelLayout layout = ChannelLayout::PLANAR);
+
+        // Accessors
+        void set(int row, int col, int channel, float value);
+        const float get(int row, int col, int channel) const;
+        ChannelView channel(int channel) const; // zero-copy, any layout
+        MatrixView plane(int channel) const;    // zero-copy, planar layout only
+        Matrix channel_matrix(int channel) const;
+
+        // Layout
+        Image to_layout(ChannelLayout layout) const;
+
+        // Color conversions (RGB and YCbCr use the ITU-R BT.709 coefficients, values in [0, 255])
+        Matrix to_gray() const; // same luma transform as Matrix::load
+        Image rgb_to_ycbcr() const;
+        Image ycbcr_to_rgb() const;
+
+        // Image operations
+        void load(const std::string &filename, ChannelLayout layout = ChannelLayout::PLANAR); // PPM (P6) as 3 channels, PGM (P5) as 1
+        void save(const std::string &filename) const; // 3 channels as PPM, 1 channel as PGM; values must be between 0 and 255
+
+    private:
+        size_t index(int row, int col, int channel) const;
+        void check_index(int row, int col, int channel) const;
+        void check_channel(int channel) const;
+        Image apply_color_matrix(const float coefficients[3][3], const float offsets[3]) const;
+    };
+}
@@ -0,0 +1,76 @@
+#include "KernelCache.hpp"
+
+namespace VisualAlgo
+{
+    namespace
+    {
+        size_t kernel_bytes(const Matrix &kernel)
+        {
+            return kernel.data.size() * sizeof(float);
+        }
+    }
+
+    KernelCache::KernelCache(size_t capacity) : capacity(capacity)
+    {
+    }
+
+    KernelCache::Kernel KernelCache::get(const std::string &kind, const std::vector<float> &parameters, const std::function<Matrix()> &build)
+    {
+        Key key = std::make_pair(kind, parameters);
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            auto entry = this->kernels.find(key);
+            if (entry != this->kernels.end())
+            {
+                this->uses.splice(this->uses.begin(), this->uses, entry->second.use);
+                return entry->second.kernel;
+            }
+        }
+
+        Kernel kernel = std::make_shared<const Matrix>(build());
+        const size_t bytes = kernel_bytes(*kernel);
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto entry = this->kernels.find(key);
+        if (entry != this->kernels.end())
+            return entry->second.kernel;
+        if (bytes > this->capacity)
+            return kernel;
+
+        while (this->stored + bytes > this->capacity)
+        {
+            auto oldest = this->kernels.find(this->uses.back());
+            this->stored -= kernel_bytes(*oldest->second.kernel);
+            this->kernels.erase(oldest);
+            this->uses.pop_back();
+        }
+        this->uses.push_front(key);
+        this->stored += bytes;
+        return this->kernels.emplace(std::move(key), Entry{std::move(kernel), this->uses.begin()}).first->second.kernel;
+    }
+
+    int KernelCache::size() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->kernels.size();
+    }
+
+    size_t KernelCache::bytes() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->stored;
+    }
+
+    void KernelCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->kernels.clear();
+        this->uses.clear();
+        this->stored = 0;
+    }
+
+    KernelCache &KernelCache::global()
+    {
+        static KernelCache cache;
+        return cache;
+    }
+}
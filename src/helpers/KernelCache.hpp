@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Matrix.hpp"
+
+namespace VisualAlgo
+{
+    // Kernels built once and shared read-only, keyed by a kind (e.g.
+    // "gaussian_1d") and the parameters they are built from. Filters that are
+    // constructed, or cells that are applied, many times with the same
+    // parameters get the same kernel instead of sampling exp, sin and cos
+    // again. Safe to share between threads.
+    //
+    // Parameters such as sigma can take any value, so the cache holds at most
+    // `capacity` bytes of kernels and drops the least recently used ones
+    // beyond that. Kernels larger than the capacity are built but not kept.
+    class KernelCache
+    {
+    public:
+        typedef std::shared_ptr<const Matrix> Kernel;
+
+        explicit KernelCache(size_t capacity = 16 << 20);
+
+        // The kernel stored under (kind, parameters), built by `build` the
+        // first time. `build` runs without the lock held, so two threads
+        // asking for a new kernel at once may both build it; the first one
+        // stored is returned to both.
+        Kernel get(const std::string &kind, const std::vector<float> &parameters, const std::function<Matrix()> &build);
+        int size() const;
+        size_t bytes() const; // taken by the kernels stored, at most the capacity
+        void clear(); // kernels already handed out stay valid
+
+        static KernelCache &global(); // shared by the filters of the library, 16 MiB
+
+    private:
+        typedef std::pair<std::string, std::vector<float>> Key;
+        struct Entry
+        {
+            Kernel kernel;
+            std::list<Key>::iterator use; // position in `uses`
+        };
+
+        mutable std::mutex mutex;
+        size_t capacity, stored = 0;
+        std::map<Key, Entry> kernels;
+        std::list<Key> uses; // most recently used first
+    };
+}
@@ -0,0 +1,154 @@
+#include "LU.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace VisualAlgo
+{
+    LU::LU(const Matrix &matrix)
+    {
+        if (matrix.rows != matrix.cols)
+            throw std::invalid_argument("Matrix must be square");
+
+        this->n = matrix.rows;
+        this->lu.resize(static_cast<size_t>(n) * n);
+        this->perm.resize(n);
+        this->sign = 1;
+        this->singular = false;
+
+        double largest = 0;
+        for (int i = 0; i < n; i++)
+        {
+            this->perm[i] = i;
+            const float *row = matrix[i];
+            for (int j = 0; j < n; j++)
+            {
+                this->lu[static_cast<size_t>(i) * n + j] = row[j];
+                largest = std::max(largest, std::fabs(static_cast<double>(row[j])));
+            }
+        }
+
+        // Pivots this small are rounding noise, the matrix is singular
+        const double tolerance = n * std::numeric_limits<double>::epsilon() * largest;
+
+        for (int k = 0; k < n; k++)
+        {
+            // Partial pivoting: bring the largest entry of column k to the diagonal
+            int pivot = k;
+            for (int i = k + 1; i < n; i++)
+                if (std::fabs(this->lu[static_cast<size_t>(i) * n + k]) > std::fabs(this->lu[static_cast<size_t>(pivot) * n + k]))
+                    pivot = i;
+            if (pivot != k)
+            {
+                for (int j = 0; j < n; j++)
+                    std::swap(this->lu[static_cast<size_t>(k) * n + j], this->lu[static_cast<size_t>(pivot) * n + j]);
+                std::swap(this->perm[k], this->perm[pivot]);
+                this->sign = -this->sign;
+            }
+
+            double *row_k = &this->lu[static_cast<size_t>(k) * n];
+            if (std::fabs(row_k[k]) <= tolerance)
+            {
+                this->singular = true;
+                continue;
+            }
+
+            // Eliminate below the pivot; the inner loop runs along contiguous rows
+            for (int i = k + 1; i < n; i++)
+            {
+                double *row_i = &this->lu[static_cast<size_t>(i) * n];
+                const double factor = row_i[k] / row_k[k];
+                row_i[k] = factor;
+                for (int j = k + 1; j < n; j++)
+                    row_i[j] -= factor * row_k[j];
+            }
+        }
+    }
+
+    int LU::size() const
+    {
+        return this->n;
+    }
+
+    bool LU::is_singular() const
+    {
+        return this->singular;
+    }
+
+    float LU::det() const
+    {
+        if (this->singular)
+            return 0;
+        double result = this->sign;
+        for (int i = 0; i < this->n; i++)
+            result *= this->lu[static_cast<size_t>(i) * this->n + i];
+        return result;
+    }
+
+    Matrix LU::solve(const Matrix &b) const
+    {
+        if (b.rows != this->n)
+            throw std::invalid_argument("Right-hand side must have " + std::to_string(this->n) + " rows. Got " + std::to_string(b.rows) + " instead.");
+        this->check_invertible();
+
+        // Work on whole rows of X so that every update is a contiguous loop over the right-hand sides
+        const int m = b.cols;
+        std::vector<double> x(static_cast<size_t>(this->n) * m);
+        for (int i = 0; i < this->n; i++)
+        {
+            const float *row = b[this->perm[i]];
+            for (int j = 0; j < m; j++)
+                x[static_cast<size_t>(i) * m + j] = row[j];
+        }
+
+        // Forward substitution, L * Y = P * b
+        for (int i = 0; i < this->n; i++)
+        {
+            double *x_i = &x[static_cast<size_t>(i) * m];
+            for (int k = 0; k < i; k++)
+            {
+                const double l = this->lu[static_cast<size_t>(i) * this->n + k];
+                const double *x_k = &x[static_cast<size_t>(k) * m];
+                for (int j = 0; j < m; j++)
+                    x_i[j] -= l * x_k[j];
+            }
+        }
+
+        // Back substitution, U * X = Y
+        for (int i = this->n - 1; i >= 0; i--)
+        {
+            double *x_i = &x[static_cast<size_t>(i) * m];
+            for (int k = i + 1; k < this->n; k++)
+            {
+                const double u = this->lu[static_cast<size_t>(i) * this->n + k];
+                const double *x_k = &x[static_cast<size_t>(k) * m];
+                for (int j = 0; j < m; j++)
+                    x_i[j] -= u * x_k[j];
+            }
+            const double diagonal = this->lu[static_cast<size_t>(i) * this->n + i];
+            for (int j = 0; j < m; j++)
+                x_i[j] /= diagonal;
+        }
+
+        Matrix result(this->n, m);
+        for (size_t i = 0; i < x.size(); i++)
+            result.data[i] = x[i];
+        return result;
+    }
+
+    Matrix LU::inverse() const
+    {
+        return this->solve(Matrix::eye(this->n, this->n));
+    }
+
+    // Private
+    void LU::check_invertible() const
+    {
+        if (this->singular)
+            throw std::invalid_argument("Matrix is not invertible");
+    }
+}
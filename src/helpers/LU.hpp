@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "Matrix.hpp"
+
+namespace VisualAlgo
+{
+    // LU factorization with partial pivoting, P * A = L * U, of a square matrix.
+    //
+    // Factorizing costs O(n^3) once; after that det() is O(1) and every
+    // solve() is O(n^2) per right-hand side, so keep the object around when
+    // the same system is solved for many right-hand sides. The factors are
+    // kept in double precision.
+    class LU
+    {
+    public:
+        explicit LU(const Matrix &matrix);
+
+        int size() const;
+        bool is_singular() const; // a pivot vanished, relative to the largest entry of the matrix
+        float det() const;        // 0 if singular
+
+        Matrix solve(const Matrix &b) const; // X such that A * X = b, for each column of b
+        Matrix inverse() const;
+
+    private:
+        int n;
+        std::vector<double> lu;  // U on and above the diagonal, L (unit diagonal omitted) below it, row-major
+        std::vector<int> perm;   // row i of P * A is row perm[i] of A
+        int sign;                // determinant of P
+        bool singular;
+
+        void check_invertible() const;
+    };
+}
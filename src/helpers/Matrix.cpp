@@ -1,4 +1,7 @@
 #include "Matrix.hpp"
+#include "Simd.hpp"
+#include "Gemm.hpp"
+#include "LU.hpp"
 
 #include <vector>
 #include <cmath>
@@ -6,6 +9,7 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
 
 namespace VisualAlgo
 {
@@ -14,6 +18,7 @@ namespace VisualAlgo
     {
         this->rows = 0;
         this->cols = 0;
+        this->stride = 0;
     }
 
     Matrix::Matrix(int rows, int cols)
@@ -22,7 +27,8 @@ namespace VisualAlgo
             throw std::invalid_argument("Matrix dimensions must be positive");
         this->rows = rows;
         this->cols = cols;
-        this->data = std::vector<std::vector<float>>(rows, std::vector<float>(cols, 0));
+        this->stride = cols;
+        this->data = std::vector<float>(static_cast<size_t>(rows) * cols, 0);
     }
 
     Matrix::Matrix(int rows, int cols, float value)
@@ -31,23 +37,57 @@ namespace VisualAlgo
             throw std::invalid_argument("Matrix dimensions must be positive");
         this->rows = rows;
         this->cols = cols;
-        this->data = std::vector<std::vector<float>>(rows, std::vector<float>(cols, value));
+        this->stride = cols;
+        this->data = std::vector<float>(static_cast<size_t>(rows) * cols, value);
     }
 
-    Matrix::Matrix(std::vector<std::vector<float>> data)
+    Matrix::Matrix(std::initializer_list<std::initializer_list<float>> data)
+    {
+        this->rows = data.size();
+        this->cols = data.size() > 0 ? data.begin()->size() : 0;
+        this->stride = this->cols;
+        this->data.reserve(static_cast<size_t>(this->rows) * this->cols);
+        for (const auto &row : data)
+        {
+            if (static_cast<int>(row.size()) != this->cols)
+                throw std::invalid_argument("All rows must have the same number of columns");
+            this->data.insert(this->data.end(), row.begin(), row.end());
+        }
+    }
+
+    Matrix::Matrix(const std::vector<std::vector<float>> &data)
     {
         this->rows = data.size();
         this->cols = data.at(0).size();
-        this->data = data;
+        this->stride = this->cols;
+        this->data.reserve(static_cast<size_t>(this->rows) * this->cols);
+        for (const auto &row : data)
+        {
+            if (static_cast<int>(row.size()) != this->cols)
+                throw std::invalid_argument("All rows must have the same number of columns");
+            this->data.insert(this->data.end(), row.begin(), row.end());
+        }
     }
 
     Matrix::Matrix(const Matrix &other)
     {
         this->rows = other.rows;
         this->cols = other.cols;
+        this->stride = other.stride;
         this->data = other.data;
     }
 
+    Matrix::Matrix(Matrix &&other) noexcept
+    {
+        this->rows = other.rows;
+        this->cols = other.cols;
+        this->stride = other.stride;
+        this->data = std::move(other.data);
+        other.rows = 0;
+        other.cols = 0;
+        other.stride = 0;
+    }
+
     // Element-wise operations
     Matrix &Matrix::operator=(const Matrix &other)
     {
@@ -55,96 +95,27 @@ namespace VisualAlgo
             return *this;
         this->rows = other.rows;
         this->cols = other.cols;
+        this->stride = other.stride;
         this->data = other.data;
         return *this;
     }
 
-    Matrix Matrix::operator+(const Matrix &other)
-    {
-        Matrix::check_dim_equal(other);
-        Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) + other.get(i, j));
-        return result;
-    }
-
-    Matrix Matrix::operator-(const Matrix &other)
-    {
-        Matrix::check_dim_equal(other);
-        Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) - other.get(i, j));
-        return result;
-    }
-
-    Matrix Matrix::operator*(const Matrix &other)
-    {
-        Matrix::check_dim_equal(other);
-        Matrix result(this->rows, other.cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) * other.get(i, j));
-        return result;
-    }
-
-    Matrix Matrix::operator/(const Matrix &other)
-    {
-        Matrix::check_dim_equal(other);
-        Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < other.cols; j++)
-                result.set(i, j, this->get(i, j) / other.get(i, j));
-        return result;
-    }
-
-    Matrix Matrix::operator+(const float &other)
-    {
-        Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) + other);
-        return result;
-    }
-
-    Matrix Matrix::operator-(const float &other)
-    {
-        Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) - other);
-        return result;
-    }
-
-    Matrix Matrix::operator*(const float &other)
-    {
-        Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) * other);
-        return result;
-    }
-
-    Matrix Matrix::operator/(const float &other)
-    {
-        Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) / other);
-        return result;
-    }
-
-    Matrix Matrix::operator-()
+    Matrix &Matrix::operator=(Matrix &&other) noexcept
     {
-        Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, -this->get(i, j));
-        return result;
+        if (this == &other)
+            return *this;
+        this->rows = other.rows;
+        this->cols = other.cols;
+        this->stride = other.stride;
+        this->data = std::move(other.data);
+        other.rows = 0;
+        other.cols = 0;
+        other.stride = 0;
+        other.data.clear();
+        return *this;
     }
 
-    Matrix Matrix::operator^(const int &other)
+    Matrix Matrix::operator^(const int &other) const
     {
         Matrix result(this->rows, this->cols, 1);
         for (int i = 0; i < other; i++)
@@ -155,52 +126,52 @@ namespace VisualAlgo
     Matrix &Matrix::operator+=(const Matrix &other)
     {
         Matrix::check_dim_equal(other);
-        *this = *this + other;
+        Simd::add(this->data.data(), other.data.data(), this->data.data(), this->data.size());
         return *this;
     }
 
     Matrix &Matrix::operator-=(const Matrix &other)
     {
         Matrix::check_dim_equal(other);
-        *this = *this - other;
+        Simd::sub(this->data.data(), other.data.data(), this->data.data(), this->data.size());
         return *this;
     }
 
     Matrix &Matrix::operator*=(const Matrix &other)
     {
         Matrix::check_dim_equal(other);
-        *this = *this * other;
+        Simd::mul(this->data.data(), other.data.data(), this->data.data(), this->data.size());
         return *this;
     }
 
     Matrix &Matrix::operator/=(const Matrix &other)
     {
         Matrix::check_dim_equal(other);
-        *this = *this / other;
+        Simd::div(this->data.data(), other.data.data(), this->data.data(), this->data.size());
         return *this;
     }
 
     Matrix &Matrix::operator+=(const float &other)
     {
-        *this = *this + other;
+        Simd::add(this->data.data(), other, this->data.data(), this->data.size());
         return *this;
     }
 
     Matrix &Matrix::operator-=(const float &other)
     {
-        *this = *this - other;
+        Simd::sub(this->data.data(), other, this->data.data(), this->data.size());
         return *this;
     }
 
     Matrix &Matrix::operator*=(const float &other)
     {
-        *this = *this * other;
+        Simd::mul(this->data.data(), other, this->data.data(), this->data.size());
         return *this;
     }
 
     Matrix &Matrix::operator/=(const float &other)
     {
-        *this = *this / other;
+        Simd::div(this->data.data(), other, this->data.data(), this->data.size());
         return *this;
     }
 
@@ -209,10 +180,10 @@ namespace VisualAlgo
     {
         if (this->rows != other.rows || this->cols != other.cols)
             return false;
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                if (this->get(i, j) != other.get(i, j))
-                    return false;
+        const size_t n = this->data.size();
+        for (size_t i = 0; i < n; i++)
+            if (this->data[i] != other.data[i])
+                return false;
         return true;
     }
 
@@ -225,13 +196,13 @@ namespace VisualAlgo
     {
         if (this->rows != other.rows || this->cols != other.cols)
             return false;
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-            {
-                float diff = this->get(i, j) - other.get(i, j);
-                if (diff < -tolerance || diff > tolerance)
-                    return false;
-            }
+        const size_t n = this->data.size();
+        for (size_t i = 0; i < n; i++)
+        {
+            float diff = this->data[i] - other.data[i];
+            if (diff < -tolerance || diff > tolerance)
+                return false;
+        }
         return true;
     }
 
@@ -239,9 +210,7 @@ namespace VisualAlgo
     {
         Matrix::check_dim_equal(other);
         Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < other.cols; j++)
-                result.set(i, j, this->get(i, j) > other.get(i, j));
+        Simd::greater(this->data.data(), other.data.data(), result.data.data(), this->data.size());
         return result;
     }
 
@@ -249,9 +218,7 @@ namespace VisualAlgo
     {
         Matrix::check_dim_equal(other);
         Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < other.cols; j++)
-                result.set(i, j, this->get(i, j) < other.get(i, j));
+        Simd::less(this->data.data(), other.data.data(), result.data.data(), this->data.size());
         return result;
     }
 
@@ -259,9 +226,7 @@ namespace VisualAlgo
     {
         Matrix::check_dim_equal(other);
         Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < other.cols; j++)
-                result.set(i, j, this->get(i, j) >= other.get(i, j));
+        Simd::greater_equal(this->data.data(), other.data.data(), result.data.data(), this->data.size());
         return result;
     }
 
@@ -269,45 +234,35 @@ namespace VisualAlgo
     {
         Matrix::check_dim_equal(other);
         Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < other.cols; j++)
-                result.set(i, j, this->get(i, j) <= other.get(i, j));
+        Simd::less_equal(this->data.data(), other.data.data(), result.data.data(), this->data.size());
         return result;
     }
 
     Matrix Matrix::operator>(const float &other) const
     {
         Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) > other);
+        Simd::greater(this->data.data(), other, result.data.data(), this->data.size());
         return result;
     }
 
     Matrix Matrix::operator<(const float &other) const
     {
         Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) < other);
+        Simd::less(this->data.data(), other, result.data.data(), this->data.size());
         return result;
     }
 
     Matrix Matrix::operator>=(const float &other) const
     {
         Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) >= other);
+        Simd::greater_equal(this->data.data(), other, result.data.data(), this->data.size());
         return result;
     }
 
     Matrix Matrix::operator<=(const float &other) const
     {
         Matrix result(this->rows, this->cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result.set(i, j, this->get(i, j) <= other);
+        Simd::less_equal(this->data.data(), other, result.data.data(), this->data.size());
         return result;
     }
 
@@ -315,53 +270,33 @@ namespace VisualAlgo
     Matrix Matrix::transpose() const
     {
         Matrix result(this->cols, this->rows);
-        for (int i = 0; i < this->cols; i++)
-            for (int j = 0; j < this->rows; j++)
-                result.set(i, j, this->get(j, i));
+        for (int i = 0; i < this->rows; i++)
+        {
+            const float *src = (*this)[i];
+            for (int j = 0; j < this->cols; j++)
+                result.data[static_cast<size_t>(j) * result.stride + i] = src[j];
+        }
         return result;
     }
 
     Matrix Matrix::submatrix(int row_start, int row_end, int col_start, int col_end) const
     {
-        if (row_start < 0 || row_end > this->rows || col_start < 0 || col_end > this->cols)
-            throw std::invalid_argument("Submatrix indices out of bounds");
-        if (row_start > row_end || col_start > col_end)
-            throw std::invalid_argument("Submatrix indices invalid");
-        if (row_start == row_end || col_start == col_end)
-            throw std::invalid_argument("Submatrix dimensions must be positive");
-        Matrix result(row_end - row_start, col_end - col_start);
-        for (int i = row_start; i < row_end; i++)
-            for (int j = col_start; j < col_end; j++)
-                result.set(i - row_start, j - col_start, this->get(i, j));
-        return result;
+        return this->view(row_start, row_end, col_start, col_end).to_matrix();
+    }
+
+    MatrixView Matrix::view() const
+    {
+        return MatrixView(*this);
+    }
+
+    MatrixView Matrix::view(int row_start, int row_end, int col_start, int col_end) const
+    {
+        return this->view().submatrix(row_start, row_end, col_start, col_end);
     }
 
     float Matrix::det() const
     {
-        if (this->rows != this->cols)
-            throw std::invalid_argument("Matrix must be square");
-        if (this->rows == 1)
-            return this->get(0, 0);
-        float result = 0;
-        for (int i = 0; i < this->rows; i++)
-        {
-            Matrix sub_matrix(this->rows - 1, this->cols - 1);
-            for (int m = 0; m < this->rows; m++)
-            {
-                if (m == i)
-                    continue; // Skip the current row
-                for (int n = 0; n < this->cols; n++)
-                {
-                    if (n == 0)
-                        continue;                    // Skip the first column
-                    int sub_i = (m < i) ? m : m - 1;
-                    int sub_j = n - 1;
-                    sub_matrix.set(sub_i, sub_j, this->get(m, n));
-                }
-            }
-            result += pow(-1, i) * this->get(i, 0) * sub_matrix.det();
-        }
-        return result;
+        return LU(*this).det();
     }
 
     Matrix Matrix::cofactor() const
@@ -395,24 +330,13 @@ namespace VisualAlgo
 
     Matrix Matrix::inverse() const
     {
-        if (this->rows != this->cols)
-            throw std::invalid_argument("Matrix must be square");
-        Matrix cofactor_matrix = this->cofactor();
-        Matrix adjugate_matrix = cofactor_matrix.transpose();
-        float det = this->det();
-        if (det == 0)
-            throw std::invalid_argument("Matrix is not invertible");
-        return adjugate_matrix / det;
+        return LU(*this).inverse();
     }
 
     float Matrix::dot(const Matrix &other) const
     {
         Matrix::check_dim_equal(other);
-        float result = 0;
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                result += this->get(i, j) * other.get(i, j);
-        return result;
+        return Simd::dot(this->data.data(), other.data.data(), this->data.size());
     }
 
     Matrix Matrix::matmul(const Matrix &other) const
@@ -420,27 +344,35 @@ namespace VisualAlgo
         if (this->cols != other.rows)
             throw std::invalid_argument("Matrix dimensions must be compatible");
         Matrix result(this->rows, other.cols);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < other.cols; j++)
-                for (int k = 0; k < this->cols; k++)
-                    result.set(i, j, result.get(i, j) + this->get(i, k) * other.get(k, j));
+        gemm(this->rows, other.cols, this->cols, this->data.data(), this->stride, other.data.data(), other.stride, result.data.data(), result.stride);
         return result;
     }
 
     // Accessors
     void Matrix::set(int row, int col, float value)
     {
-        this->data.at(row).at(col) = value;
+        if (row < 0 || row >= this->rows || col < 0 || col >= this->cols)
+            throw std::out_of_range("Matrix index (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+        this->data[static_cast<size_t>(row) * this->stride + col] = value;
     }
 
     const float Matrix::get(int row, int col) const
     {
-        return this->data.at(row).at(col);
+        if (row < 0 || row >= this->rows || col < 0 || col >= this->cols)
+            throw std::out_of_range("Matrix index (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+        return this->data[static_cast<size_t>(row) * this->stride + col];
     }
 
-    std::vector<float> &Matrix::operator[](int row)
+    float *Matrix::operator[](int row)
     {
-        return this->data.at(row);
+        check_row(row);
+        return this->data.data() + static_cast<size_t>(row) * this->stride;
+    }
+
+    const float *Matrix::operator[](int row) const
+    {
+        check_row(row);
+        return this->data.data() + static_cast<size_t>(row) * this->stride;
     }
 
     std::ostream &operator<<(std::ostream &os, const Matrix &matrix)
@@ -464,55 +396,38 @@ namespace VisualAlgo
     }
 
     // Statistics
-    float Matrix::sum()
+    float Matrix::sum() const
     {
-        float sum = 0;
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-                sum += this->get(i, j);
-        return sum;
+        return Simd::sum(this->data.data(), this->data.size());
     }
 
-    float Matrix::mean()
+    float Matrix::mean() const
     {
         return this->sum() / (this->rows * this->cols);
     }
 
-    float Matrix::std()
+    float Matrix::std() const
     {
         float mean = this->mean();
         float std = 0;
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-            {
-                float diff = this->get(i, j) - mean;
-                std += diff * diff;
-            }
+        for (float value : this->data)
+        {
+            float diff = value - mean;
+            std += diff * diff;
+        }
         return sqrt(std / (this->rows * this->cols));
     }
 
-    float Matrix::max()
+    float Matrix::max() const
     {
-        float max = this->get(0, 0);
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-            {
-                if (this->data[i][j] > max)
-                    max = this->get(i, j);
-            }
-        return max;
+        this->get(0, 0); // throws on an empty matrix
+        return Simd::max(this->data.data(), this->data.size());
     }
 
-    float Matrix::min()
+    float Matrix::min() const
     {
-        float min = this->data[0][0];
-        for (int i = 0; i < this->rows; i++)
-            for (int j = 0; j < this->cols; j++)
-            {
-                if (this->data[i][j] < min)
-                    min = this->get(i, j);
-            }
-        return min;
+        this->get(0, 0); // throws on an empty matrix
+        return Simd::min(this->data.data(), this->data.size());
     }
 
     // Image operations
@@ -538,18 +453,22 @@ namespace VisualAlgo
 
         file.get(); // consume newline
 
-        this->data = std::vector<std::vector<float>>(rows, std::vector<float>(cols, 0));
+        this->stride = this->cols;
+        this->data = std::vector<float>(static_cast<size_t>(rows) * cols, 0);
 
+        // Read one scanline at a time instead of one byte at a time
+        std::vector<unsigned char> scanline(static_cast<size_t>(cols) * 3);
         for (int i = 0; i < rows; ++i)
         {
+            file.read(reinterpret_cast<char *>(scanline.data()), scanline.size());
+            float *row = (*this)[i];
             for (int j = 0; j < cols; ++j)
             {
-                unsigned char r, g, b;
-                file.read(reinterpret_cast<char *>(&r), 1);
-                file.read(reinterpret_cast<char *>(&g), 1);
-                file.read(reinterpret_cast<char *>(&b), 1);
+                unsigned char r = scanline[3 * j];
+                unsigned char g = scanline[3 * j + 1];
+                unsigned char b = scanline[3 * j + 2];
                 // convert RGB to grayscale using the ITU-R BT.709 luma transform
-                this->set(i, j, 0.2126 * r + 0.7152 * g + 0.0722 * b);
+                row[j] = 0.2126 * r + 0.7152 * g + 0.0722 * b;
             }
         }
     }
@@ -585,210 +504,91 @@ namespace VisualAlgo
         file << copy.cols << " " << copy.rows << "\n";
         file << 255 << "\n";
 
+        std::vector<unsigned char> scanline(static_cast<size_t>(cols) * 3);
         for (int i = 0; i < rows; ++i)
         {
+            const float *row = copy[i];
             for (int j = 0; j < cols; ++j)
             {
-                unsigned char pixel = static_cast<unsigned char>(copy.get(i, j));
-                file.write(reinterpret_cast<char *>(&pixel), 1); // R
-                file.write(reinterpret_cast<char *>(&pixel), 1); // G
-                file.write(reinterpret_cast<char *>(&pixel), 1); // B
+                unsigned char pixel = static_cast<unsigned char>(row[j]);
+                scanline[3 * j] = pixel;     // R
+                scanline[3 * j + 1] = pixel; // G
+                scanline[3 * j + 2] = pixel; // B
             }
+            file.write(reinterpret_cast<char *>(scanline.data()), scanline.size());
         }
     }
 
     void Matrix::normalize()
     {
-        float min_value = this->get(0, 0);
-        float max_value = this->get(0, 0);
-
-        for (const auto &row : this->data)
-        {
-            for (const auto &value : row)
-            {
-                min_value = std::min(min_value, value);
-                max_value = std::max(max_value, value);
-            }
-        }
+        float min_value = this->min();
+        float max_value = this->max();
 
         float range = max_value - min_value;
         if (range == 0)
             return;
-        for (auto &row : this->data)
-        {
-            for (auto &value : row)
-            {
-                value = (value - min_value) / range;
-            }
-        }
+        Simd::normalize(this->data.data(), this->data.data(), this->data.size(), min_value, range, 1);
     }
 
     void Matrix::normalize255()
     {
-        float min_value = this->get(0, 0);
-        float max_value = this->get(0, 0);
-
-        for (const auto &row : this->data)
-        {
-            for (const auto &value : row)
-            {
-                min_value = std::min(min_value, value);
-                max_value = std::max(max_value, value);
-            }
-        }
+        float min_value = this->min();
+        float max_value = this->max();
 
         float range = max_value - min_value;
         if (range == 0)
             return;
-        for (auto &row : this->data)
-        {
-            for (auto &value : row)
-            {
-                value = ((value - min_value) / range) * 255;
-            }
-        }
+        Simd::normalize(this->data.data(), this->data.data(), this->data.size(), min_value, range, 255);
     }
 
     void Matrix::relu()
     {
-        for (auto &row : this->data)
-        {
-            for (auto &value : row)
-            {
-                value = std::max(value, 0.0f);
-            }
-        }
+        Simd::relu(this->data.data(), this->data.data(), this->data.size());
     }
 
     void Matrix::abs()
     {
-        for (auto &row : this->data)
-        {
-            for (auto &value : row)
-            {
-                value = std::abs(value);
-            }
-        }
+        Simd::abs(this->data.data(), this->data.data(), this->data.size());
     }
 
-    Matrix Matrix::cross_correlate(const VisualAlgo::Matrix &kernel, int padding, int stride) const // TODO: Vectorize
+    Matrix Matrix::cross_correlate(const VisualAlgo::Matrix &kernel, int padding, int stride, BorderMode border, float value) const
     {
-        if (kernel.rows > rows || kernel.cols > cols)
-        {
-            throw std::invalid_argument("Kernel dimensions cannot be larger than the input matrix dimensions.");
-        }
-
-        if (stride <= 0)
-        {
-            throw std::invalid_argument("Stride must be a positive integer.");
-        }
-
-        if (padding < 0)
-        {
-            throw std::invalid_argument("Padding cannot be negative.");
-        }
-        int out_rows = (rows + 2 * padding - kernel.rows) / stride + 1;
-        int out_cols = (cols + 2 * padding - kernel.cols) / stride + 1;
-
-        VisualAlgo::Matrix output(out_rows, out_cols, 0);
-
-        for (int i = 0; i < out_rows; ++i)
-        {
-            for (int j = 0; j < out_cols; ++j)
-            {
-                float sum = 0;
-                for (int p = 0; p < kernel.rows; ++p)
-                {
-                    for (int q = 0; q < kernel.cols; ++q)
-                    {
-                        int y = stride * i + p - padding;
-                        int x = stride * j + q - padding;
-
-                        // If within bounds of original image
-                        if (x >= 0 && y >= 0 && x < cols && y < rows)
-                        {
-                            sum += get(y, x) * kernel.get(p, q);
-                        }
-                    }
-                }
-                output.set(i, j, sum);
-            }
-        }
-
-        return output;
+        return this->view().cross_correlate(kernel, padding, stride, border, value);
     }
 
-    Matrix Matrix::cross_correlate(const VisualAlgo::Matrix &kernel) const
+    Matrix Matrix::cross_correlate(const VisualAlgo::Matrix &kernel, BorderMode border, float value) const
     {
-        VisualAlgo::Matrix output(rows, cols);
-
-        int kernel_center_y = kernel.rows / 2;
-        int kernel_center_x = kernel.cols / 2;
-
-        for (int i = 0; i < rows; ++i)
-        {
-            for (int j = 0; j < cols; ++j)
-            {
-                float sum = 0;
-                for (int p = 0; p < kernel.rows; ++p)
-                {
-                    for (int q = 0; q < kernel.cols; ++q)
-                    {
-                        // Compute coordinates in input image, including possible overhang
-                        int y = i + p - kernel_center_y;
-                        int x = j + q - kernel_center_x;
-
-                        // Handle overhang with mirror padding
-                        if (y < 0)
-                        {
-                            y = -y;
-                        }
-                        if (y >= rows)
-                        {
-                            y = 2 * rows - y - 1;
-                        }
-                        if (x < 0)
-                        {
-                            x = -x;
-                        }
-                        if (x >= cols)
-                        {
-                            x = 2 * cols - x - 1;
-                        }
-
-                        sum += get(y, x) * kernel.get(p, q);
-                    }
-                }
-                output.set(i, j, sum);
-            }
-        }
-
-        return output;
+        return this->view().cross_correlate(kernel, border, value);
     }
 
     Matrix Matrix::flip() const
     {
         Matrix flipped(rows, cols);
         for (int i = 0; i < rows; i++)
-        {
-            for (int j = 0; j < cols; j++)
-            {
-                flipped.set(i, j, get(rows - i - 1, cols - j - 1));
-            }
-        }
+            std::reverse_copy((*this)[rows - i - 1], (*this)[rows - i - 1] + cols, flipped[i]);
         return flipped;
     }
 
-    Matrix Matrix::convolve(const VisualAlgo::Matrix &kernel, int padding, int stride) const
+    Matrix Matrix::convolve(const VisualAlgo::Matrix &kernel, int padding, int stride, BorderMode border, float value) const
     {
         Matrix flipped_kernel = kernel.flip();
-        return this->cross_correlate(flipped_kernel, padding, stride);
+        return this->cross_correlate(flipped_kernel, padding, stride, border, value);
     }
 
-    Matrix Matrix::convolve(const VisualAlgo::Matrix &kernel) const
+    Matrix Matrix::convolve(const VisualAlgo::Matrix &kernel, BorderMode border, float value) const
     {
         Matrix flipped_kernel = kernel.flip();
-        return this->cross_correlate(flipped_kernel);
+        return this->cross_correlate(flipped_kernel, border, value);
+    }
+
+    Matrix Matrix::cross_correlate_separable(const VisualAlgo::Matrix &column, const VisualAlgo::Matrix &row, BorderMode border, float value) const
+    {
+        return this->view().cross_correlate_separable(column, row, border, value);
+    }
+
+    Matrix Matrix::convolve_separable(const VisualAlgo::Matrix &column, const VisualAlgo::Matrix &row, BorderMode border, float value) const
+    {
+        return this->view().convolve_separable(column, row, border, value);
     }
 
     // Functions
@@ -824,13 +624,16 @@ namespace VisualAlgo
         return result;
     }
 
+    Matrix Matrix::solve(const Matrix &a, const Matrix &b)
+    {
+        return LU(a).solve(b);
+    }
+
     Matrix Matrix::elementwise_max(const Matrix &a, const Matrix &b)
     {
         Matrix::check_dim_equal(a, b);
         Matrix result(a.rows, a.cols);
-        for (int i = 0; i < a.rows; i++)
-            for (int j = 0; j < a.cols; j++)
-                result.set(i, j, std::max(a.get(i, j), b.get(i, j)));
+        Simd::maximum(a.data.data(), b.data.data(), result.data.data(), a.data.size());
         return result;
     }
 
@@ -838,13 +641,17 @@ namespace VisualAlgo
     {
         Matrix::check_dim_equal(a, b);
         Matrix result(a.rows, a.cols);
-        for (int i = 0; i < a.rows; i++)
-            for (int j = 0; j < a.cols; j++)
-                result.set(i, j, std::min(a.get(i, j), b.get(i, j)));
+        Simd::minimum(a.data.data(), b.data.data(), result.data.data(), a.data.size());
         return result;
     }
 
     // Private
+    void Matrix::check_row(int row) const
+    {
+        if (row < 0 || row >= this->rows)
+            throw std::out_of_range("Matrix row " + std::to_string(row) + " out of range");
+    }
+
     void Matrix::check_dim_equal(const Matrix &other) const
     {
         if (this->rows != other.rows || this->cols != other.cols)
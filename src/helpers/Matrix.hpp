@@ -3,6 +3,13 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "MatrixView.hpp"
+#include "MatrixExpr.hpp"
 
 namespace VisualAlgo
 {
@@ -10,28 +17,32 @@ namespace VisualAlgo
     {
         // Attributes
         int rows, cols;
-        std::vector<std::vector<float>> data;
+        int stride;              // distance (in elements) between the starts of two consecutive rows
+        std::vector<float> data; // contiguous row-major buffer, element (i, j) is data[i * stride + j]
 
         // Constructors
         Matrix();
         Matrix(int rows, int cols);
         Matrix(int rows, int cols, float value);
-        Matrix(std::vector<std::vector<float>> data);
+        Matrix(std::initializer_list<std::initializer_list<float>> data);
+        Matrix(const std::vector<std::vector<float>> &data);
         Matrix(const Matrix &other);
+        Matrix(Matrix &&other) noexcept;
+
+        // Evaluates an element-wise expression (see MatrixExpr.hpp) in a single pass,
+        // reusing the buffer of an expiring operand when there is one
+        template <typename E>
+            requires MatrixExpression<std::remove_cvref_t<E>>
+        Matrix(E &&expr);
 
-        // Element-wise operations
+        // Element-wise operations. The binary +, -, *, / operators (matrix and
+        // scalar forms) and unary - are lazy and declared in MatrixExpr.hpp.
         Matrix &operator=(const Matrix &other);
-        Matrix operator+(const Matrix &other);
-        Matrix operator-(const Matrix &other);
-        Matrix operator*(const Matrix &other);
-        Matrix operator/(const Matrix &other);
-
-        Matrix operator+(const float &other);
-        Matrix operator-(const float &other);
-        Matrix operator*(const float &other);
-        Matrix operator/(const float &other);
-        Matrix operator-();
-        Matrix operator^(const int &other);
+        Matrix &operator=(Matrix &&other) noexcept;
+        template <typename E>
+            requires MatrixExpression<std::remove_cvref_t<E>>
+        Matrix &operator=(E &&expr);
+        Matrix operator^(const int &other) const;
 
         Matrix &operator+=(const Matrix &other);
         Matrix &operator-=(const Matrix &other);
@@ -43,6 +54,15 @@ namespace VisualAlgo
         Matrix &operator*=(const float &other);
         Matrix &operator/=(const float &other);
 
+        template <MatrixExpression E>
+        Matrix &operator+=(const E &expr);
+        template <MatrixExpression E>
+        Matrix &operator-=(const E &expr);
+        template <MatrixExpression E>
+        Matrix &operator*=(const E &expr);
+        template <MatrixExpression E>
+        Matrix &operator/=(const E &expr);
+
         // Comparison
         bool operator==(const Matrix &other) const;
         bool operator!=(const Matrix &other) const;
@@ -62,24 +82,27 @@ namespace VisualAlgo
         // Matrix operations
         Matrix transpose() const;
         Matrix submatrix(int row_start, int row_end, int col_start, int col_end) const;
-        float det() const;
+        MatrixView view() const;
+        MatrixView view(int row_start, int row_end, int col_start, int col_end) const; // zero-copy submatrix
+        float det() const;      // via LU factorization, see LU.hpp
         Matrix cofactor() const;
-        Matrix inverse() const;
+        Matrix inverse() const; // via LU factorization, see LU.hpp
         float dot(const Matrix &other) const;
         Matrix matmul(const Matrix &other) const;
 
         // Accessors
         void set(int row, int col, float value);
         const float get(int row, int col) const;
-        std::vector<float> &operator[](int row);
+        float *operator[](int row);             // pointer to the first element of the row
+        const float *operator[](int row) const;
         friend std::ostream &operator<<(std::ostream &os, const Matrix &matrix);
 
         // Statistics
-        float sum();
-        float mean();
-        float std();
-        float max();
-        float min();
+        float sum() const;
+        float mean() const;
+        float std() const;
+        float max() const;
+        float min() const;
 
         // Image operations
         void load(const std::string& filename);
@@ -89,11 +112,13 @@ namespace VisualAlgo
         void normalize255(); // [0, 255.0]
         void relu();
         void abs();
-        Matrix cross_correlate(const VisualAlgo::Matrix &kernel, int padding, int stride) const;
-        Matrix cross_correlate(const VisualAlgo::Matrix &kernel) const;  // keeps the same size, does wrap around
+        Matrix cross_correlate(const VisualAlgo::Matrix &kernel, int padding, int stride, BorderMode border = BorderMode::CONSTANT, float value = 0) const;
+        Matrix cross_correlate(const VisualAlgo::Matrix &kernel, BorderMode border = BorderMode::REFLECT_101, float value = 0) const;  // keeps the same size
         Matrix flip() const;
-        Matrix convolve(const VisualAlgo::Matrix &kernel, int padding, int stride) const;
-        Matrix convolve(const VisualAlgo::Matrix &kernel) const;  // keeps the same size, does wrap around
+        Matrix convolve(const VisualAlgo::Matrix &kernel, int padding, int stride, BorderMode border = BorderMode::CONSTANT, float value = 0) const;
+        Matrix convolve(const VisualAlgo::Matrix &kernel, BorderMode border = BorderMode::REFLECT_101, float value = 0) const;  // keeps the same size
+        Matrix cross_correlate_separable(const VisualAlgo::Matrix &column, const VisualAlgo::Matrix &row, BorderMode border = BorderMode::REFLECT_101, float value = 0) const;  // kernel = column * row
+        Matrix convolve_separable(const VisualAlgo::Matrix &column, const VisualAlgo::Matrix &row, BorderMode border = BorderMode::REFLECT_101, float value = 0) const;  // kernel = column * row
 
         // Functions
         static Matrix zeros(int rows, int cols);
@@ -101,12 +126,100 @@ namespace VisualAlgo
         static Matrix eye(int rows, int cols);
         static Matrix random(int rows, int cols);
         static Matrix random(int rows, int cols, float min, float max);
+        static Matrix solve(const Matrix &a, const Matrix &b); // X such that a * X = b; use LU directly to reuse the factorization
         static Matrix elementwise_max(const Matrix &a, const Matrix &b);
         static Matrix elementwise_min(const Matrix &a, const Matrix &b);
 
     private:
+        void check_row(int row) const;
         void check_dim_equal(const Matrix &other) const;
         static void check_dim_equal(const Matrix &a, const Matrix &b);
+        template <typename E, typename Op>
+        void apply_expr(const E &expr, Op op);
     };
 
+    // Expression templates
+    inline MatrixLeaf as_expr(const Matrix &matrix)
+    {
+        return MatrixLeaf{matrix.data.data(), matrix.rows, matrix.cols};
+    }
+
+    inline MatrixTempLeaf as_expr(Matrix &&matrix)
+    {
+        MatrixTempLeaf leaf(std::move(matrix.data), matrix.rows, matrix.cols);
+        matrix = Matrix();
+        return leaf;
+    }
+
+    template <typename E, typename Op>
+    void Matrix::apply_expr(const E &expr, Op op)
+    {
+        if (this->rows != expr.rows || this->cols != expr.cols)
+            throw std::invalid_argument("Matrix dimensions must be equal. Got " + std::to_string(this->rows) + "x" + std::to_string(this->cols) + " and " + std::to_string(expr.rows) + "x" + std::to_string(expr.cols) + " instead.");
+        const size_t n = this->data.size();
+        float *out = this->data.data();
+        for (size_t i = 0; i < n; i++)
+            out[i] = op(out[i], expr.eval(i));
+    }
+
+    template <typename E>
+        requires MatrixExpression<std::remove_cvref_t<E>>
+    Matrix::Matrix(E &&expr) : Matrix()
+    {
+        *this = std::forward<E>(expr);
+    }
+
+    template <typename E>
+        requires MatrixExpression<std::remove_cvref_t<E>>
+    Matrix &Matrix::operator=(E &&expr)
+    {
+        // Every element only depends on the operands at the same index, so
+        // evaluating in place is safe even if this matrix, or the buffer taken
+        // over from an expiring operand, appears in expr.
+        if (this->rows != expr.rows || this->cols != expr.cols)
+        {
+            std::vector<float> *buffer = nullptr;
+            if constexpr (!std::is_lvalue_reference_v<E>)
+                buffer = expr.storage();
+            if (buffer)
+                this->data = std::move(*buffer);
+            else
+                this->data = std::vector<float>(static_cast<size_t>(expr.rows) * expr.cols);
+            this->rows = expr.rows;
+            this->cols = expr.cols;
+            this->stride = expr.cols;
+        }
+        if (!evaluate_simd(expr, this->data.data()))
+            apply_expr(expr, [](float, float b) { return b; });
+        return *this;
+    }
+
+    template <MatrixExpression E>
+    Matrix &Matrix::operator+=(const E &expr)
+    {
+        apply_expr(expr, [](float a, float b) { return a + b; });
+        return *this;
+    }
+
+    template <MatrixExpression E>
+    Matrix &Matrix::operator-=(const E &expr)
+    {
+        apply_expr(expr, [](float a, float b) { return a - b; });
+        return *this;
+    }
+
+    template <MatrixExpression E>
+    Matrix &Matrix::operator*=(const E &expr)
+    {
+        apply_expr(expr, [](float a, float b) { return a * b; });
+        return *this;
+    }
+
+    template <MatrixExpression E>
+    Matrix &Matrix::operator/=(const E &expr)
+    {
+        apply_expr(expr, [](float a, float b) { return a / b; });
+        return *this;
+    }
+
 }
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cstddef>
+#include <concepts>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Simd.hpp"
+
+namespace VisualAlgo
+{
+    struct Matrix;
+
+    // Expression templates for element-wise Matrix arithmetic.
+    //
+    // `a + b`, `a * 2.0f`, `-a`, ... do not compute anything: they return small
+    // nodes that remember their operands. The whole tree is evaluated in one
+    // fused loop when it is assigned to a Matrix (or passed to one of the
+    // compound assignment operators), so `(a - b) * (s * s)` reads a and b once
+    // and writes the result once, without materializing `a - b`.
+    //
+    // Nodes hold pointers into the buffers of lvalue operands, so an expression
+    // must be evaluated within the full-expression that created it. Do not
+    // store one in an `auto` variable. Expiring (rvalue) Matrix operands are
+    // moved into the expression instead, and the result reuses their buffer.
+
+    // Anything with a shape and a flat element accessor is an expression.
+    // storage() returns a buffer owned by the expression that the result may
+    // take over, or nullptr.
+    template <typename E>
+    concept MatrixExpression = requires(const E &e, E &m, size_t i) {
+        { e.eval(i) } -> std::convertible_to<float>;
+        { e.rows } -> std::convertible_to<int>;
+        { e.cols } -> std::convertible_to<int>;
+        { m.storage() } -> std::same_as<std::vector<float> *>;
+    };
+
+    // Leaf: a Matrix read through its contiguous buffer.
+    struct MatrixLeaf
+    {
+        const float *data;
+        int rows, cols;
+
+        float eval(size_t i) const { return data[i]; }
+        std::vector<float> *storage() { return nullptr; }
+    };
+
+    // Leaf: an expiring Matrix whose buffer now belongs to the expression.
+    // `data` keeps pointing at the elements even after the buffer has been
+    // moved into the result, which is what makes in-place evaluation work.
+    struct MatrixTempLeaf
+    {
+        std::vector<float> buffer;
+        const float *data;
+        int rows, cols;
+
+        MatrixTempLeaf(std::vector<float> &&buffer, int rows, int cols) : buffer(std::move(buffer)), data(this->buffer.data()), rows(rows), cols(cols) {}
+        MatrixTempLeaf(MatrixTempLeaf &&other) noexcept : buffer(std::move(other.buffer)), data(other.data), rows(other.rows), cols(other.cols) {}
+        MatrixTempLeaf(const MatrixTempLeaf &other) : buffer(other.buffer), data(buffer.data()), rows(other.rows), cols(other.cols) {}
+
+        float eval(size_t i) const { return data[i]; }
+        std::vector<float> *storage() { return buffer.empty() ? nullptr : &buffer; }
+    };
+
+    // defined in Matrix.hpp
+    inline MatrixLeaf as_expr(const Matrix &matrix);
+    inline MatrixTempLeaf as_expr(Matrix &&matrix);
+
+    template <MatrixExpression E>
+    inline std::remove_cvref_t<E> as_expr(E &&expr)
+    {
+        return std::forward<E>(expr);
+    }
+
+    // Valid operands of the element-wise operators.
+    template <typename T>
+    concept MatrixOperand = std::same_as<std::remove_cvref_t<T>, Matrix> || MatrixExpression<std::remove_cvref_t<T>>;
+
+    // Each operation also names its Simd kernels, which evaluate the nodes
+    // that only combine leaves and scalars (see evaluate_simd).
+    namespace ExprOp
+    {
+        struct Add
+        {
+            static constexpr bool commutative = true;
+            static float apply(float a, float b) { return a + b; }
+            static void simd(const float *a, const float *b, float *out, size_t n) { Simd::add(a, b, out, n); }
+            static void simd(const float *a, float b, float *out, size_t n) { Simd::add(a, b, out, n); }
+        };
+        struct Sub
+        {
+            static constexpr bool commutative = false;
+            static float apply(float a, float b) { return a - b; }
+            static void simd(const float *a, const float *b, float *out, size_t n) { Simd::sub(a, b, out, n); }
+            static void simd(const float *a, float b, float *out, size_t n) { Simd::sub(a, b, out, n); }
+        };
+        struct Mul
+        {
+            static constexpr bool commutative = true;
+            static float apply(float a, float b) { return a * b; }
+            static void simd(const float *a, const float *b, float *out, size_t n) { Simd::mul(a, b, out, n); }
+            static void simd(const float *a, float b, float *out, size_t n) { Simd::mul(a, b, out, n); }
+        };
+        struct Div
+        {
+            static constexpr bool commutative = false;
+            static float apply(float a, float b) { return a / b; }
+            static void simd(const float *a, const float *b, float *out, size_t n) { Simd::div(a, b, out, n); }
+            static void simd(const float *a, float b, float *out, size_t n) { Simd::div(a, b, out, n); }
+        };
+    }
+
+    template <typename L, typename R, typename Op>
+    struct MatrixBinaryExpr
+    {
+        L lhs;
+        R rhs;
+        int rows, cols;
+
+        MatrixBinaryExpr(L &&lhs, R &&rhs) : lhs(std::move(lhs)), rhs(std::move(rhs)), rows(this->lhs.rows), cols(this->lhs.cols)
+        {
+            if (this->lhs.rows != this->rhs.rows || this->lhs.cols != this->rhs.cols)
+                throw std::invalid_argument("Matrix dimensions must be equal. Got " + std::to_string(this->lhs.rows) + "x" + std::to_string(this->lhs.cols) + " and " + std::to_string(this->rhs.rows) + "x" + std::to_string(this->rhs.cols) + " instead.");
+        }
+
+        float eval(size_t i) const { return Op::apply(lhs.eval(i), rhs.eval(i)); }
+
+        std::vector<float> *storage()
+        {
+            std::vector<float> *buffer = lhs.storage();
+            return buffer ? buffer : rhs.storage();
+        }
+    };
+
+    // Matrix (op) scalar, or scalar (op) matrix when scalar_first is set.
+    template <typename E, typename Op, bool scalar_first>
+    struct MatrixScalarExpr
+    {
+        E expr;
+        float scalar;
+        int rows, cols;
+
+        MatrixScalarExpr(E &&expr, float scalar) : expr(std::move(expr)), scalar(scalar), rows(this->expr.rows), cols(this->expr.cols) {}
+
+        float eval(size_t i) const
+        {
+            if constexpr (scalar_first)
+                return Op::apply(scalar, expr.eval(i));
+            else
+                return Op::apply(expr.eval(i), scalar);
+        }
+
+        std::vector<float> *storage() { return expr.storage(); }
+    };
+
+    template <typename E>
+    struct MatrixNegateExpr
+    {
+        E expr;
+        int rows, cols;
+
+        explicit MatrixNegateExpr(E &&expr) : expr(std::move(expr)), rows(this->expr.rows), cols(this->expr.cols) {}
+
+        float eval(size_t i) const { return -expr.eval(i); }
+        std::vector<float> *storage() { return expr.storage(); }
+    };
+
+    template <typename E>
+    using ExprOf = decltype(as_expr(std::declval<E>()));
+
+    template <typename E>
+    concept MatrixLeafExpression = std::same_as<E, MatrixLeaf> || std::same_as<E, MatrixTempLeaf>;
+
+    // The most common nodes, a (op) b and a (op) s on leaves, are written by
+    // the Simd kernels of the active instruction set into out, which may be
+    // the buffer of a leaf. Returns false for the other expressions, which
+    // are left to the fused scalar loop.
+    template <typename E>
+    inline bool evaluate_simd(const E &, float *)
+    {
+        return false;
+    }
+
+    template <MatrixLeafExpression L, MatrixLeafExpression R, typename Op>
+    inline bool evaluate_simd(const MatrixBinaryExpr<L, R, Op> &expr, float *out)
+    {
+        Op::simd(expr.lhs.data, expr.rhs.data, out, static_cast<size_t>(expr.rows) * expr.cols);
+        return true;
+    }
+
+    template <MatrixLeafExpression E, typename Op, bool scalar_first>
+    inline bool evaluate_simd(const MatrixScalarExpr<E, Op, scalar_first> &expr, float *out)
+    {
+        if constexpr (scalar_first && !Op::commutative)
+            return false;
+        else
+        {
+            Op::simd(expr.expr.data, expr.scalar, out, static_cast<size_t>(expr.rows) * expr.cols);
+            return true;
+        }
+    }
+
+    // Matrix (op) Matrix
+    template <MatrixOperand L, MatrixOperand R>
+    inline auto operator+(L &&lhs, R &&rhs)
+    {
+        return MatrixBinaryExpr<ExprOf<L>, ExprOf<R>, ExprOp::Add>(as_expr(std::forward<L>(lhs)), as_expr(std::forward<R>(rhs)));
+    }
+
+    template <MatrixOperand L, MatrixOperand R>
+    inline auto operator-(L &&lhs, R &&rhs)
+    {
+        return MatrixBinaryExpr<ExprOf<L>, ExprOf<R>, ExprOp::Sub>(as_expr(std::forward<L>(lhs)), as_expr(std::forward<R>(rhs)));
+    }
+
+    template <MatrixOperand L, MatrixOperand R>
+    inline auto operator*(L &&lhs, R &&rhs)
+    {
+        return MatrixBinaryExpr<ExprOf<L>, ExprOf<R>, ExprOp::Mul>(as_expr(std::forward<L>(lhs)), as_expr(std::forward<R>(rhs)));
+    }
+
+    template <MatrixOperand L, MatrixOperand R>
+    inline auto operator/(L &&lhs, R &&rhs)
+    {
+        return MatrixBinaryExpr<ExprOf<L>, ExprOf<R>, ExprOp::Div>(as_expr(std::forward<L>(lhs)), as_expr(std::forward<R>(rhs)));
+    }
+
+    // Matrix (op) scalar
+    template <MatrixOperand L>
+    inline auto operator+(L &&lhs, float rhs)
+    {
+        return MatrixScalarExpr<ExprOf<L>, ExprOp::Add, false>(as_expr(std::forward<L>(lhs)), rhs);
+    }
+
+    template <MatrixOperand L>
+    inline auto operator-(L &&lhs, float rhs)
+    {
+        return MatrixScalarExpr<ExprOf<L>, ExprOp::Sub, false>(as_expr(std::forward<L>(lhs)), rhs);
+    }
+
+    template <MatrixOperand L>
+    inline auto operator*(L &&lhs, float rhs)
+    {
+        return MatrixScalarExpr<ExprOf<L>, ExprOp::Mul, false>(as_expr(std::forward<L>(lhs)), rhs);
+    }
+
+    template <MatrixOperand L>
+    inline auto operator/(L &&lhs, float rhs)
+    {
+        return MatrixScalarExpr<ExprOf<L>, ExprOp::Div, false>(as_expr(std::forward<L>(lhs)), rhs);
+    }
+
+    // scalar (op) Matrix
+    template <MatrixOperand R>
+    inline auto operator+(float lhs, R &&rhs)
+    {
+        return MatrixScalarExpr<ExprOf<R>, ExprOp::Add, true>(as_expr(std::forward<R>(rhs)), lhs);
+    }
+
+    template <MatrixOperand R>
+    inline auto operator-(float lhs, R &&rhs)
+    {
+        return MatrixScalarExpr<ExprOf<R>, ExprOp::Sub, true>(as_expr(std::forward<R>(rhs)), lhs);
+    }
+
+    template <MatrixOperand R>
+    inline auto operator*(float lhs, R &&rhs)
+    {
+        return MatrixScalarExpr<ExprOf<R>, ExprOp::Mul, true>(as_expr(std::forward<R>(rhs)), lhs);
+    }
+
+    template <MatrixOperand R>
+    inline auto operator/(float lhs, R &&rhs)
+    {
+        return MatrixScalarExpr<ExprOf<R>, ExprOp::Div, true>(as_expr(std::forward<R>(rhs)), lhs);
+    }
+
+    // -Matrix
+    template <MatrixOperand E>
+    inline auto operator-(E &&expr)
+    {
+        return MatrixNegateExpr<ExprOf<E>>(as_expr(std::forward<E>(expr)));
+    }
+}
@@ -0,0 +1,219 @@
+#include "MatrixView.hpp"
+#include "Matrix.hpp"
+#include "Convolution.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace VisualAlgo
+{
+    // Constructors
+    MatrixView::MatrixView()
+    {
+        this->data = nullptr;
+        this->rows = 0;
+        this->cols = 0;
+        this->stride = 0;
+    }
+
+    MatrixView::MatrixView(const float *data, int rows, int cols, int stride)
+    {
+        if (rows < 0 || cols < 0)
+            throw std::invalid_argument("View dimensions must be positive");
+        if (stride < cols)
+            throw std::invalid_argument("View stride must be at least the number of columns");
+        this->data = data;
+        this->rows = rows;
+        this->cols = cols;
+        this->stride = stride;
+    }
+
+    MatrixView::MatrixView(const Matrix &matrix)
+    {
+        this->data = matrix.data.data();
+        this->rows = matrix.rows;
+        this->cols = matrix.cols;
+        this->stride = matrix.stride;
+    }
+
+    // Accessors
+    const float MatrixView::get(int row, int col) const
+    {
+        if (row < 0 || row >= this->rows || col < 0 || col >= this->cols)
+            throw std::out_of_range("View index (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+        return this->data[static_cast<size_t>(row) * this->stride + col];
+    }
+
+    const float *MatrixView::operator[](int row) const
+    {
+        check_row(row);
+        return this->data + static_cast<size_t>(row) * this->stride;
+    }
+
+    std::ostream &operator<<(std::ostream &os, const MatrixView &view)
+    {
+        return os << view.to_matrix();
+    }
+
+    // Views
+    MatrixView MatrixView::submatrix(int row_start, int row_end, int col_start, int col_end) const
+    {
+        if (row_start < 0 || row_end > this->rows || col_start < 0 || col_end > this->cols)
+            throw std::invalid_argument("Submatrix indices out of bounds");
+        if (row_start > row_end || col_start > col_end)
+            throw std::invalid_argument("Submatrix indices invalid");
+        if (row_start == row_end || col_start == col_end)
+            throw std::invalid_argument("Submatrix dimensions must be positive");
+        return MatrixView(this->data + static_cast<size_t>(row_start) * this->stride + col_start,
+                          row_end - row_start, col_end - col_start, this->stride);
+    }
+
+    bool MatrixView::is_contiguous() const
+    {
+        return this->stride == this->cols;
+    }
+
+    Matrix MatrixView::to_matrix() const
+    {
+        Matrix result(this->rows, this->cols);
+        for (int i = 0; i < this->rows; i++)
+            std::copy((*this)[i], (*this)[i] + this->cols, result[i]);
+        return result;
+    }
+
+    Matrix MatrixView::pad(int top, int bottom, int left, int right, BorderMode border, float value) const
+    {
+        if (top < 0 || bottom < 0 || left < 0 || right < 0)
+            throw std::invalid_argument("Padding cannot be negative.");
+
+        Matrix result(this->rows + top + bottom, this->cols + left + right, value);
+
+        // Source column of every padded column, -1 for the constant value
+        std::vector<int> source_cols(left + right);
+        for (int j = 0; j < left; j++)
+            source_cols[j] = border_index(j - left, this->cols, border);
+        for (int j = 0; j < right; j++)
+            source_cols[left + j] = border_index(this->cols + j, this->cols, border);
+
+        for (int i = 0; i < result.rows; i++)
+        {
+            int y = border_index(i - top, this->rows, border);
+            if (y < 0)
+                continue;
+            const float *in = (*this)[y];
+            float *out = result[i];
+            std::copy(in, in + this->cols, out + left);
+            for (int j = 0; j < left; j++)
+                if (source_cols[j] >= 0)
+                    out[j] = in[source_cols[j]];
+            for (int j = 0; j < right; j++)
+                if (source_cols[left + j] >= 0)
+                    out[left + this->cols + j] = in[source_cols[left + j]];
+        }
+        return result;
+    }
+
+    bool separate_kernel(const MatrixView &kernel, Matrix &column, Matrix &row, float tolerance)
+    {
+        if (kernel.rows == 0 || kernel.cols == 0)
+            return false;
+
+        // Pivot on the largest entry: kernel = kernel[:, q] * kernel[p, :] / kernel[p][q] if the rank is 1
+        int pivot_row = 0, pivot_col = 0;
+        float largest = 0;
+        for (int i = 0; i < kernel.rows; i++)
+            for (int j = 0; j < kernel.cols; j++)
+                if (std::abs(kernel[i][j]) > largest)
+                {
+                    largest = std::abs(kernel[i][j]);
+                    pivot_row = i;
+                    pivot_col = j;
+                }
+        if (largest == 0)
+            return false;
+
+        Matrix candidate_column(kernel.rows, 1), candidate_row(1, kernel.cols);
+        for (int i = 0; i < kernel.rows; i++)
+            candidate_column[i][0] = kernel[i][pivot_col];
+        for (int j = 0; j < kernel.cols; j++)
+            candidate_row[0][j] = kernel[pivot_row][j] / kernel[pivot_row][pivot_col];
+
+        for (int i = 0; i < kernel.rows; i++)
+            for (int j = 0; j < kernel.cols; j++)
+                if (std::abs(candidate_column[i][0] * candidate_row[0][j] - kernel[i][j]) > tolerance * largest)
+                    return false;
+
+        column = std::move(candidate_column);
+        row = std::move(candidate_row);
+        return true;
+    }
+
+    // Image operations
+    //
+    // Both cross-correlations extend the input once, with the requested border
+    // mode, and then correlate over the padded buffer where every tap is in
+    // range. Convolution::correlate_valid picks the algorithm for the kernel.
+    Matrix MatrixView::cross_correlate(const MatrixView &kernel, int padding, int stride, BorderMode border, float value) const
+    {
+        if (kernel.rows > rows || kernel.cols > cols)
+        {
+            throw std::invalid_argument("Kernel dimensions cannot be larger than the input matrix dimensions.");
+        }
+
+        if (stride <= 0)
+        {
+            throw std::invalid_argument("Stride must be a positive integer.");
+        }
+
+        if (padding < 0)
+        {
+            throw std::invalid_argument("Padding cannot be negative.");
+        }
+
+        if (padding == 0)
+            return Convolution::correlate_valid(*this, kernel, stride);
+        Matrix padded = this->pad(padding, padding, padding, padding, border, value);
+        return Convolution::correlate_valid(padded, kernel, stride);
+    }
+
+    Matrix MatrixView::cross_correlate(const MatrixView &kernel, BorderMode border, float value) const
+    {
+        return Convolution::cross_correlate(*this, kernel, border, value);
+    }
+
+    Matrix MatrixView::cross_correlate_separable(const MatrixView &column, const MatrixView &row, BorderMode border, float value) const
+    {
+        int kernel_rows = column.rows * column.cols, kernel_cols = row.rows * row.cols;
+        Matrix padded = this->pad(kernel_rows / 2, std::max(kernel_rows - 1 - kernel_rows / 2, 0),
+                                  kernel_cols / 2, std::max(kernel_cols - 1 - kernel_cols / 2, 0), border, value);
+        return Convolution::correlate_valid_separable(padded, column, row);
+    }
+
+    Matrix MatrixView::convolve(const MatrixView &kernel, int padding, int stride, BorderMode border, float value) const
+    {
+        Matrix flipped_kernel = kernel.to_matrix().flip();
+        return this->cross_correlate(flipped_kernel, padding, stride, border, value);
+    }
+
+    Matrix MatrixView::convolve(const MatrixView &kernel, BorderMode border, float value) const
+    {
+        Matrix flipped_kernel = kernel.to_matrix().flip();
+        return this->cross_correlate(flipped_kernel, border, value);
+    }
+
+    Matrix MatrixView::convolve_separable(const MatrixView &column, const MatrixView &row, BorderMode border, float value) const
+    {
+        return this->cross_correlate_separable(column.to_matrix().flip(), row.to_matrix().flip(), border, value);
+    }
+
+    // Private
+    void MatrixView::check_row(int row) const
+    {
+        if (row < 0 || row >= this->rows)
+            throw std::out_of_range("View row " + std::to_string(row) + " out of range");
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <iostream>
+
+#include "Border.hpp"
+
+namespace VisualAlgo
+{
+    struct Matrix;
+
+    // Non-owning, read-only window onto a row-major float buffer. A view never
+    // allocates: it only remembers where its first element is, how big it is,
+    // and how far apart its rows are in the underlying buffer. The caller is
+    // responsible for keeping the viewed Matrix alive while the view is used.
+    struct MatrixView
+    {
+        // Attributes
+        const float *data;
+        int rows, cols;
+        int stride; // distance (in elements) between the starts of two consecutive rows
+
+        // Constructors
+        MatrixView();
+        MatrixView(const float *data, int rows, int cols, int stride);
+        MatrixView(const Matrix &matrix); // implicit, so a Matrix can be passed wherever a view is expected
+
+        // Accessors
+        const float get(int row, int col) const;
+        const float *operator[](int row) const; // pointer to the first element of the row
+        friend std::ostream &operator<<(std::ostream &os, const MatrixView &view);
+
+        // Views
+        MatrixView submatrix(int row_start, int row_end, int col_start, int col_end) const; // zero-copy
+        bool is_contiguous() const;
+        Matrix to_matrix() const;
+        Matrix pad(int top, int bottom, int left, int right, BorderMode border, float value = 0) const; // value is used by BorderMode::CONSTANT
+
+        // Image operations
+        Matrix cross_correlate(const MatrixView &kernel, int padding, int stride, BorderMode border = BorderMode::CONSTANT, float value = 0) const;
+        Matrix cross_correlate(const MatrixView &kernel, BorderMode border = BorderMode::REFLECT_101, float value = 0) const; // keeps the same size
+        Matrix convolve(const MatrixView &kernel, int padding, int stride, BorderMode border = BorderMode::CONSTANT, float value = 0) const;
+        Matrix convolve(const MatrixView &kernel, BorderMode border = BorderMode::REFLECT_101, float value = 0) const; // keeps the same size
+
+        // Same-size correlation with the rank-1 kernel column * row, as two 1D
+        // passes. Both factors are vectors (either orientation) of taps. The
+        // functions above already take this path for kernels that separate_kernel splits.
+        Matrix cross_correlate_separable(const MatrixView &column, const MatrixView &row, BorderMode border = BorderMode::REFLECT_101, float value = 0) const;
+        Matrix convolve_separable(const MatrixView &column, const MatrixView &row, BorderMode border = BorderMode::REFLECT_101, float value = 0) const;
+
+    private:
+        void check_row(int row) const;
+    };
+
+    // Splits a rank-1 kernel into a column vector and a row vector whose
+    // product matches it within `tolerance` times its largest entry. Returns
+    // false, leaving column and row untouched, if the kernel is not rank 1.
+    bool separate_kernel(const MatrixView &kernel, Matrix &column, Matrix &row, float tolerance = 1e-5f);
+
+}
@@ -0,0 +1,444 @@
+#include "Simd.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define VISUALALGO_SIMD_X86 1
+#else
+#define VISUALALGO_SIMD_X86 0
+#endif
+
+// AVX-512 implies FMA, and GCC would otherwise fuse a * b + c there. Keeping
+// every multiply and add separately rounded makes the element-wise kernels
+// return the same bits on every instruction set.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace VisualAlgo::Simd
+{
+    namespace
+    {
+        struct Kernels
+        {
+            void (*add)(const float *, const float *, float *, size_t);
+            void (*sub)(const float *, const float *, float *, size_t);
+            void (*mul)(const float *, const float *, float *, size_t);
+            void (*div)(const float *, const float *, float *, size_t);
+            void (*maximum)(const float *, const float *, float *, size_t);
+            void (*minimum)(const float *, const float *, float *, size_t);
+            void (*greater)(const float *, const float *, float *, size_t);
+            void (*less)(const float *, const float *, float *, size_t);
+            void (*greater_equal)(const float *, const float *, float *, size_t);
+            void (*less_equal)(const float *, const float *, float *, size_t);
+            void (*add_scalar)(const float *, float, float *, size_t);
+            void (*sub_scalar)(const float *, float, float *, size_t);
+            void (*mul_scalar)(const float *, float, float *, size_t);
+            void (*div_scalar)(const float *, float, float *, size_t);
+            void (*greater_scalar)(const float *, float, float *, size_t);
+            void (*less_scalar)(const float *, float, float *, size_t);
+            void (*greater_equal_scalar)(const float *, float, float *, size_t);
+            void (*less_equal_scalar)(const float *, float, float *, size_t);
+            void (*relu)(const float *, float *, size_t);
+            void (*abs)(const float *, float *, size_t);
+            void (*normalize)(const float *, float *, size_t, float, float, float);
+            void (*combine3)(const float *, const float *, const float *, float *, size_t, float, float, float, float);
+            void (*correlate_row)(const float *, const float *, size_t, float *, size_t);
+            void (*correlate_square3)(const float *const *, const float *, float *, size_t);
+            void (*correlate_square5)(const float *const *, const float *, float *, size_t);
+            float (*sum)(const float *, size_t);
+            float (*dot)(const float *, const float *, size_t);
+            float (*max)(const float *, size_t);
+            float (*min)(const float *, size_t);
+        };
+
+        // Portable fallback, element by element in index order.
+        namespace scalar
+        {
+            static void add(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] + b[i];
+            }
+
+            static void sub(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] - b[i];
+            }
+
+            static void mul(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] * b[i];
+            }
+
+            static void div(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] / b[i];
+            }
+
+            static void maximum(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] < b[i] ? b[i] : a[i];
+            }
+
+            static void minimum(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = b[i] < a[i] ? b[i] : a[i];
+            }
+
+            static void greater(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] > b[i];
+            }
+
+            static void less(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] < b[i];
+            }
+
+            static void greater_equal(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] >= b[i];
+            }
+
+            static void less_equal(const float *a, const float *b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] <= b[i];
+            }
+
+            static void add_scalar(const float *a, float b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] + b;
+            }
+
+            static void sub_scalar(const float *a, float b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] - b;
+            }
+
+            static void mul_scalar(const float *a, float b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] * b;
+            }
+
+            static void div_scalar(const float *a, float b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] / b;
+            }
+
+            static void greater_scalar(const float *a, float b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] > b;
+            }
+
+            static void less_scalar(const float *a, float b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] < b;
+            }
+
+            static void greater_equal_scalar(const float *a, float b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] >= b;
+            }
+
+            static void less_equal_scalar(const float *a, float b, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] <= b;
+            }
+
+            static void relu(const float *a, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] < 0 ? 0 : a[i];
+            }
+
+            static void abs(const float *a, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = a[i] < 0 ? -a[i] : a[i];
+            }
+
+            static void normalize(const float *a, float *out, size_t n, float min_value, float range, float scale)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = ((a[i] - min_value) / range) * scale;
+            }
+
+            static void combine3(const float *a, const float *b, const float *c, float *out, size_t n, float wa, float wb, float wc, float offset)
+            {
+                for (size_t i = 0; i < n; i++)
+                    out[i] = wa * a[i] + wb * b[i] + wc * c[i] + offset;
+            }
+
+            static void correlate_row(const float *in, const float *kernel, size_t taps, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    float sum = out[i];
+                    for (size_t q = 0; q < taps; q++)
+                        sum += in[i + q] * kernel[q];
+                    out[i] = sum;
+                }
+            }
+
+            template <size_t K>
+            static void correlate_square(const float *const *rows, const float *kernel, float *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    float sum = out[i];
+                    for (size_t p = 0; p < K; p++)
+                        for (size_t q = 0; q < K; q++)
+                            sum += rows[p][i + q] * kernel[p * K + q];
+                    out[i] = sum;
+                }
+            }
+
+            static void correlate_square3(const float *const *rows, const float *kernel, float *out, size_t n)
+            {
+                correlate_square<3>(rows, kernel, out, n);
+            }
+
+            static void correlate_square5(const float *const *rows, const float *kernel, float *out, size_t n)
+            {
+                correlate_square<5>(rows, kernel, out, n);
+            }
+
+            static float sum(const float *a, size_t n)
+            {
+                float result = 0;
+                for (size_t i = 0; i < n; i++)
+                    result += a[i];
+                return result;
+            }
+
+            static float dot(const float *a, const float *b, size_t n)
+            {
+                float result = 0;
+                for (size_t i = 0; i < n; i++)
+                    result += a[i] * b[i];
+                return result;
+            }
+
+            static float max(const float *a, size_t n)
+            {
+                float result = a[0];
+                for (size_t i = 1; i < n; i++)
+                    if (a[i] > result)
+                        result = a[i];
+                return result;
+            }
+
+            static float min(const float *a, size_t n)
+            {
+                float result = a[0];
+                for (size_t i = 1; i < n; i++)
+                    if (a[i] < result)
+                        result = a[i];
+                return result;
+            }
+
+            static const Kernels kernels = {
+                add, sub, mul, div, maximum, minimum,
+                greater, less, greater_equal, less_equal,
+                add_scalar, sub_scalar, mul_scalar, div_scalar,
+                greater_scalar, less_scalar, greater_equal_scalar, less_equal_scalar,
+                relu, abs, normalize, combine3, correlate_row, correlate_square3, correlate_square5,
+                sum, dot, max, min};
+        }
+
+#if VISUALALGO_SIMD_X86
+// The vector-typed helpers in SimdKernels.inl never cross a translation unit,
+// so the ABI note GCC emits for them does not apply.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+        namespace sse4
+        {
+#define VISUALALGO_SIMD_BYTES 16
+#include "SimdKernels.inl"
+#undef VISUALALGO_SIMD_BYTES
+        }
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+        namespace avx2
+        {
+#define VISUALALGO_SIMD_BYTES 32
+#include "SimdKernels.inl"
+#undef VISUALALGO_SIMD_BYTES
+        }
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+        namespace avx512
+        {
+#define VISUALALGO_SIMD_BYTES 64
+#include "SimdKernels.inl"
+#undef VISUALALGO_SIMD_BYTES
+        }
+#pragma GCC pop_options
+
+#pragma GCC diagnostic pop
+#endif
+
+        const Kernels *kernels_for(Isa isa)
+        {
+            switch (isa)
+            {
+#if VISUALALGO_SIMD_X86
+            case Isa::SSE4:
+                return &sse4::kernels;
+            case Isa::AVX2:
+                return &avx2::kernels;
+            case Isa::AVX512:
+                return &avx512::kernels;
+#endif
+            default:
+                return &scalar::kernels;
+            }
+        }
+
+        std::atomic<const Kernels *> &active_kernels()
+        {
+            static std::atomic<const Kernels *> active(kernels_for(best_isa()));
+            return active;
+        }
+
+        std::atomic<Isa> &active_isa_storage()
+        {
+            static std::atomic<Isa> isa(best_isa());
+            return isa;
+        }
+
+        inline const Kernels &k()
+        {
+            return *active_kernels().load(std::memory_order_relaxed);
+        }
+    }
+
+    std::string to_string(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::SCALAR:
+            return "scalar";
+        case Isa::SSE4:
+            return "sse4";
+        case Isa::AVX2:
+            return "avx2";
+        case Isa::AVX512:
+            return "avx512";
+        default:
+            return "unknown";
+        }
+    }
+
+    bool is_supported(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::SCALAR:
+            return true;
+#if VISUALALGO_SIMD_X86
+        case Isa::SSE4:
+            return __builtin_cpu_supports("sse4.1");
+        case Isa::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case Isa::AVX512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+        }
+    }
+
+    Isa best_isa()
+    {
+        for (Isa isa : {Isa::AVX512, Isa::AVX2, Isa::SSE4})
+            if (is_supported(isa))
+                return isa;
+        return Isa::SCALAR;
+    }
+
+    Isa active_isa()
+    {
+        return active_isa_storage().load();
+    }
+
+    void set_isa(Isa isa)
+    {
+        if (!is_supported(isa))
+            throw std::invalid_argument("Instruction set " + to_string(isa) + " is not supported by this CPU.");
+        active_isa_storage().store(isa);
+        active_kernels().store(kernels_for(isa));
+    }
+
+    void add(const float *a, const float *b, float *out, size_t n) { k().add(a, b, out, n); }
+    void sub(const float *a, const float *b, float *out, size_t n) { k().sub(a, b, out, n); }
+    void mul(const float *a, const float *b, float *out, size_t n) { k().mul(a, b, out, n); }
+    void div(const float *a, const float *b, float *out, size_t n) { k().div(a, b, out, n); }
+    void maximum(const float *a, const float *b, float *out, size_t n) { k().maximum(a, b, out, n); }
+    void minimum(const float *a, const float *b, float *out, size_t n) { k().minimum(a, b, out, n); }
+    void greater(const float *a, const float *b, float *out, size_t n) { k().greater(a, b, out, n); }
+    void less(const float *a, const float *b, float *out, size_t n) { k().less(a, b, out, n); }
+    void greater_equal(const float *a, const float *b, float *out, size_t n) { k().greater_equal(a, b, out, n); }
+    void less_equal(const float *a, const float *b, float *out, size_t n) { k().less_equal(a, b, out, n); }
+
+    void add(const float *a, float b, float *out, size_t n) { k().add_scalar(a, b, out, n); }
+    void sub(const float *a, float b, float *out, size_t n) { k().sub_scalar(a, b, out, n); }
+    void mul(const float *a, float b, float *out, size_t n) { k().mul_scalar(a, b, out, n); }
+    void div(const float *a, float b, float *out, size_t n) { k().div_scalar(a, b, out, n); }
+    void greater(const float *a, float b, float *out, size_t n) { k().greater_scalar(a, b, out, n); }
+    void less(const float *a, float b, float *out, size_t n) { k().less_scalar(a, b, out, n); }
+    void greater_equal(const float *a, float b, float *out, size_t n) { k().greater_equal_scalar(a, b, out, n); }
+    void less_equal(const float *a, float b, float *out, size_t n) { k().less_equal_scalar(a, b, out, n); }
+
+    void relu(const float *a, float *out, size_t n) { k().relu(a, out, n); }
+    void abs(const float *a, float *out, size_t n) { k().abs(a, out, n); }
+    void normalize(const float *a, float *out, size_t n, float min_value, float range, float scale) { k().normalize(a, out, n, min_value, range, scale); }
+    void combine3(const float *a, const float *b, const float *c, float *out, size_t n, float wa, float wb, float wc, float offset) { k().combine3(a, b, c, out, n, wa, wb, wc, offset); }
+    void correlate_row(const float *in, const float *kernel, size_t taps, float *out, size_t n) { k().correlate_row(in, kernel, taps, out, n); }
+
+    void correlate_square(const float *const *rows, const float *kernel, size_t size, float *out, size_t n)
+    {
+        switch (size)
+        {
+        case 3:
+            return k().correlate_square3(rows, kernel, out, n);
+        case 5:
+            return k().correlate_square5(rows, kernel, out, n);
+        default:
+            throw std::invalid_argument("correlate_square is only specialized for 3x3 and 5x5 kernels. Got " + std::to_string(size) + "x" + std::to_string(size) + " instead.");
+        }
+    }
+
+    float sum(const float *a, size_t n) { return k().sum(a, n); }
+    float dot(const float *a, const float *b, size_t n) { return k().dot(a, b, n); }
+    float max(const float *a, size_t n) { return k().max(a, n); }
+    float min(const float *a, size_t n) { return k().min(a, n); }
+}
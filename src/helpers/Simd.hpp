@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace VisualAlgo::Simd
+{
+    // Instruction sets the kernels below are compiled for. The best one the
+    // CPU supports is picked at runtime, the first time a kernel is called.
+    enum class Isa
+    {
+        SCALAR,
+        SSE4,
+        AVX2,
+        AVX512
+    };
+
+    std::string to_string(Isa isa);
+
+    bool is_supported(Isa isa);
+    Isa best_isa();
+    Isa active_isa();
+    void set_isa(Isa isa); // mainly for testing; throws if the CPU does not support isa
+
+    // Element-wise kernels over n contiguous floats. `out` may alias an input.
+    void add(const float *a, const float *b, float *out, size_t n);
+    void sub(const float *a, const float *b, float *out, size_t n);
+    void mul(const float *a, const float *b, float *out, size_t n);
+    void div(const float *a, const float *b, float *out, size_t n);
+    void maximum(const float *a, const float *b, float *out, size_t n);
+    void minimum(const float *a, const float *b, float *out, size_t n);
+
+    // Comparisons write 1.0f where true and 0.0f where false
+    void greater(const float *a, const float *b, float *out, size_t n);
+    void less(const float *a, const float *b, float *out, size_t n);
+    void greater_equal(const float *a, const float *b, float *out, size_t n);
+    void less_equal(const float *a, const float *b, float *out, size_t n);
+
+    void add(const float *a, float b, float *out, size_t n);
+    void sub(const float *a, float b, float *out, size_t n);
+    void mul(const float *a, float b, float *out, size_t n);
+    void div(const float *a, float b, float *out, size_t n);
+    void greater(const float *a, float b, float *out, size_t n);
+    void less(const float *a, float b, float *out, size_t n);
+    void greater_equal(const float *a, float b, float *out, size_t n);
+    void less_equal(const float *a, float b, float *out, size_t n);
+
+    void relu(const float *a, float *out, size_t n);
+    void abs(const float *a, float *out, size_t n);
+    void normalize(const float *a, float *out, size_t n, float min_value, float range, float scale); // ((a - min_value) / range) * scale
+    void combine3(const float *a, const float *b, const float *c, float *out, size_t n, float wa, float wb, float wc, float offset); // wa * a + wb * b + wc * c + offset, e.g. one channel of a color conversion
+
+    // One kernel row of a cross-correlation: out[j] += in[j] * kernel[0] + ... + in[j + taps - 1] * kernel[taps - 1],
+    // added to out[j] one tap at a time, left to right, on every instruction set. `in` must hold n + taps - 1 floats.
+    void correlate_row(const float *in, const float *kernel, size_t taps, float *out, size_t n);
+
+    // A whole size x size kernel, stored row by row, over the input rows rows[0], ..., rows[size - 1] in one pass:
+    // the same sums, in the same order, as correlate_row over each row with the matching kernel row. Unrolled
+    // for size 3 and 5 only, throws std::invalid_argument for other sizes (see has_correlate_square).
+    void correlate_square(const float *const *rows, const float *kernel, size_t size, float *out, size_t n);
+    constexpr bool has_correlate_square(int size) { return size == 3 || size == 5; }
+
+    // Reductions. The summation order differs between instruction sets, so
+    // sum() and dot() only agree up to rounding. max() and min() need n > 0.
+    float sum(const float *a, size_t n);
+    float dot(const float *a, const float *b, size_t n);
+    float max(const float *a, size_t n);
+    float min(const float *a, size_t n);
+}
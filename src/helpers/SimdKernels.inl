@@ -0,0 +1,324 @@
+// Element-wise and reduction kernels written once with GCC vector extensions.
+//
+// Simd.cpp includes this file once per instruction set, inside its own
+// namespace and a `#pragma GCC target(...)` region, after defining
+// VISUALALGO_SIMD_BYTES to the vector width of that instruction set. Every
+// function below is therefore compiled for that target only and must only be
+// called after checking the CPU supports it.
+
+typedef float vfloat __attribute__((vector_size(VISUALALGO_SIMD_BYTES)));
+typedef int vint __attribute__((vector_size(VISUALALGO_SIMD_BYTES)));
+
+constexpr size_t W = VISUALALGO_SIMD_BYTES / sizeof(float);
+
+static inline vfloat load(const float *p)
+{
+    vfloat v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void store(float *p, vfloat v)
+{
+    std::memcpy(p, &v, sizeof(v));
+}
+
+static inline vfloat splat(float value)
+{
+    return vfloat{} + value;
+}
+
+// Loads the last n < W elements, filling the remaining lanes with `fill`
+static inline vfloat load_partial(const float *p, size_t n, float fill)
+{
+    float buffer[W];
+    for (size_t k = 0; k < W; k++)
+        buffer[k] = k < n ? p[k] : fill;
+    return load(buffer);
+}
+
+static inline void store_partial(float *p, vfloat v, size_t n)
+{
+    float buffer[W];
+    store(buffer, v);
+    std::memcpy(p, buffer, n * sizeof(float));
+}
+
+// 1.0f where the mask is set, 0.0f elsewhere
+static inline vfloat select_one(vint mask)
+{
+    return (vfloat)(mask & (vint)splat(1.0f));
+}
+
+template <typename Op>
+static inline void map1(const float *a, float *out, size_t n, Op op)
+{
+    size_t i = 0;
+    for (; i + W <= n; i += W)
+        store(out + i, op(load(a + i)));
+    if (i < n)
+        store_partial(out + i, op(load_partial(a + i, n - i, 0)), n - i);
+}
+
+template <typename Op>
+static inline void map2(const float *a, const float *b, float *out, size_t n, Op op)
+{
+    size_t i = 0;
+    for (; i + W <= n; i += W)
+        store(out + i, op(load(a + i), load(b + i)));
+    if (i < n)
+        store_partial(out + i, op(load_partial(a + i, n - i, 0), load_partial(b + i, n - i, 1)), n - i);
+}
+
+// Folds all elements into one accumulator per lane. Tail lanes are padded
+// with `fill`, which must not change the result.
+template <typename Op>
+static inline vfloat fold(const float *a, size_t n, vfloat acc, float fill, Op op)
+{
+    size_t i = 0;
+    for (; i + W <= n; i += W)
+        acc = op(acc, load(a + i));
+    if (i < n)
+        acc = op(acc, load_partial(a + i, n - i, fill));
+    return acc;
+}
+
+// Binary element-wise operations
+static void add(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return x + y; });
+}
+
+static void sub(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return x - y; });
+}
+
+static void mul(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return x * y; });
+}
+
+static void div(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return x / y; });
+}
+
+static void maximum(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return x < y ? y : x; });
+}
+
+static void minimum(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return y < x ? y : x; });
+}
+
+static void greater(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return select_one(x > y); });
+}
+
+static void less(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return select_one(x < y); });
+}
+
+static void greater_equal(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return select_one(x >= y); });
+}
+
+static void less_equal(const float *a, const float *b, float *out, size_t n)
+{
+    map2(a, b, out, n, [](vfloat x, vfloat y) { return select_one(x <= y); });
+}
+
+// Matrix-scalar operations
+static void add_scalar(const float *a, float b, float *out, size_t n)
+{
+    vfloat s = splat(b);
+    map1(a, out, n, [s](vfloat x) { return x + s; });
+}
+
+static void sub_scalar(const float *a, float b, float *out, size_t n)
+{
+    vfloat s = splat(b);
+    map1(a, out, n, [s](vfloat x) { return x - s; });
+}
+
+static void mul_scalar(const float *a, float b, float *out, size_t n)
+{
+    vfloat s = splat(b);
+    map1(a, out, n, [s](vfloat x) { return x * s; });
+}
+
+static void div_scalar(const float *a, float b, float *out, size_t n)
+{
+    vfloat s = splat(b);
+    map1(a, out, n, [s](vfloat x) { return x / s; });
+}
+
+static void greater_scalar(const float *a, float b, float *out, size_t n)
+{
+    vfloat s = splat(b);
+    map1(a, out, n, [s](vfloat x) { return select_one(x > s); });
+}
+
+static void less_scalar(const float *a, float b, float *out, size_t n)
+{
+    vfloat s = splat(b);
+    map1(a, out, n, [s](vfloat x) { return select_one(x < s); });
+}
+
+static void greater_equal_scalar(const float *a, float b, float *out, size_t n)
+{
+    vfloat s = splat(b);
+    map1(a, out, n, [s](vfloat x) { return select_one(x >= s); });
+}
+
+static void less_equal_scalar(const float *a, float b, float *out, size_t n)
+{
+    vfloat s = splat(b);
+    map1(a, out, n, [s](vfloat x) { return select_one(x <= s); });
+}
+
+// Unary operations
+static void relu(const float *a, float *out, size_t n)
+{
+    vfloat zero = splat(0);
+    map1(a, out, n, [zero](vfloat x) { return x < zero ? zero : x; });
+}
+
+static void abs(const float *a, float *out, size_t n)
+{
+    vint mask = vint{} + 0x7fffffff;
+    map1(a, out, n, [mask](vfloat x) { return (vfloat)((vint)x & mask); });
+}
+
+static void normalize(const float *a, float *out, size_t n, float min_value, float range, float scale)
+{
+    vfloat lo = splat(min_value), r = splat(range), s = splat(scale);
+    map1(a, out, n, [lo, r, s](vfloat x) { return ((x - lo) / r) * s; });
+}
+
+static void combine3(const float *a, const float *b, const float *c, float *out, size_t n, float wa, float wb, float wc, float offset)
+{
+    vfloat va = splat(wa), vb = splat(wb), vc = splat(wc), vo = splat(offset);
+    size_t i = 0;
+    for (; i + W <= n; i += W)
+        store(out + i, va * load(a + i) + vb * load(b + i) + vc * load(c + i) + vo);
+    if (i < n)
+        store_partial(out + i, va * load_partial(a + i, n - i, 0) + vb * load_partial(b + i, n - i, 0) + vc * load_partial(c + i, n - i, 0) + vo, n - i);
+}
+
+// Each lane keeps its own running sum, so taps are added in the same order as the scalar version
+static void correlate_row(const float *in, const float *kernel, size_t taps, float *out, size_t n)
+{
+    size_t i = 0;
+    for (; i + W <= n; i += W)
+    {
+        vfloat sum = load(out + i);
+        for (size_t q = 0; q < taps; q++)
+            sum += load(in + i + q) * splat(kernel[q]);
+        store(out + i, sum);
+    }
+    if (i < n)
+    {
+        vfloat sum = load_partial(out + i, n - i, 0);
+        for (size_t q = 0; q < taps; q++)
+            sum += load_partial(in + i + q, n - i, 0) * splat(kernel[q]);
+        store_partial(out + i, sum, n - i);
+    }
+}
+
+// A whole K x K kernel at once, unrolled at compile time with every tap
+// held in a register, so out is loaded and stored once instead of once per
+// kernel row. The taps are added in the same order as correlate_row over
+// rows[0], ..., rows[K - 1].
+template <size_t K>
+static void correlate_square(const float *const *rows, const float *kernel, float *out, size_t n)
+{
+    vfloat taps[K * K];
+    for (size_t t = 0; t < K * K; t++)
+        taps[t] = splat(kernel[t]);
+    size_t i = 0;
+    for (; i + W <= n; i += W)
+    {
+        vfloat sum = load(out + i);
+        for (size_t p = 0; p < K; p++)
+            for (size_t q = 0; q < K; q++)
+                sum += load(rows[p] + i + q) * taps[p * K + q];
+        store(out + i, sum);
+    }
+    if (i < n)
+    {
+        vfloat sum = load_partial(out + i, n - i, 0);
+        for (size_t p = 0; p < K; p++)
+            for (size_t q = 0; q < K; q++)
+                sum += load_partial(rows[p] + i + q, n - i, 0) * taps[p * K + q];
+        store_partial(out + i, sum, n - i);
+    }
+}
+
+static void correlate_square3(const float *const *rows, const float *kernel, float *out, size_t n)
+{
+    correlate_square<3>(rows, kernel, out, n);
+}
+
+static void correlate_square5(const float *const *rows, const float *kernel, float *out, size_t n)
+{
+    correlate_square<5>(rows, kernel, out, n);
+}
+
+// Reductions
+static float sum(const float *a, size_t n)
+{
+    vfloat acc = fold(a, n, splat(0), 0, [](vfloat acc, vfloat x) { return acc + x; });
+    float result = 0;
+    for (size_t k = 0; k < W; k++)
+        result += acc[k];
+    return result;
+}
+
+static float dot(const float *a, const float *b, size_t n)
+{
+    vfloat acc = splat(0);
+    size_t i = 0;
+    for (; i + W <= n; i += W)
+        acc += load(a + i) * load(b + i);
+    if (i < n)
+        acc += load_partial(a + i, n - i, 0) * load_partial(b + i, n - i, 0);
+    float result = 0;
+    for (size_t k = 0; k < W; k++)
+        result += acc[k];
+    return result;
+}
+
+static float max(const float *a, size_t n)
+{
+    vfloat acc = fold(a, n, splat(a[0]), a[0], [](vfloat acc, vfloat x) { return x > acc ? x : acc; });
+    float result = acc[0];
+    for (size_t k = 1; k < W; k++)
+        if (acc[k] > result)
+            result = acc[k];
+    return result;
+}
+
+static float min(const float *a, size_t n)
+{
+    vfloat acc = fold(a, n, splat(a[0]), a[0], [](vfloat acc, vfloat x) { return x < acc ? x : acc; });
+    float result = acc[0];
+    for (size_t k = 1; k < W; k++)
+        if (acc[k] < result)
+            result = acc[k];
+    return result;
+}
+
+static const Kernels kernels = {
+    add, sub, mul, div, maximum, minimum,
+    greater, less, greater_equal, less_equal,
+    add_scalar, sub_scalar, mul_scalar, div_scalar,
+    greater_scalar, less_scalar, greater_equal_scalar, less_equal_scalar,
+    relu, abs, normalize, combine3, correlate_row, correlate_square3, correlate_square5,
+    sum, dot, max, min};
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "Matrix.hpp"
+
+namespace VisualAlgo
+{
+    // Fixed-size R x C matrix stored inline, for the small transforms and
+    // homogeneous points of geometric code. Unlike Matrix it never allocates,
+    // its size is part of its type, and all operations are constexpr, so loops
+    // over its elements have constant trip counts the compiler fully unrolls.
+    template <int R, int C>
+    struct SmallMatrix
+    {
+        static_assert(R > 0 && C > 0, "SmallMatrix dimensions must be positive");
+
+        // Attributes
+        static constexpr int rows = R;
+        static constexpr int cols = C;
+        float data[R][C] = {};
+
+        // Constructors
+        constexpr SmallMatrix() = default;
+
+        explicit constexpr SmallMatrix(float value)
+        {
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    data[i][j] = value;
+        }
+
+        constexpr SmallMatrix(std::initializer_list<std::initializer_list<float>> values)
+        {
+            if (static_cast<int>(values.size()) != R)
+                throw std::invalid_argument("Expected " + std::to_string(R) + " rows. Got " + std::to_string(values.size()) + " instead.");
+            int i = 0;
+            for (const auto &row : values)
+            {
+                if (static_cast<int>(row.size()) != C)
+                    throw std::invalid_argument("All rows must have " + std::to_string(C) + " columns");
+                int j = 0;
+                for (float value : row)
+                    data[i][j++] = value;
+                i++;
+            }
+        }
+
+        explicit SmallMatrix(const Matrix &matrix)
+        {
+            if (matrix.rows != R || matrix.cols != C)
+                throw std::invalid_argument("Matrix dimensions must be " + std::to_string(R) + "x" + std::to_string(C) + ". Got " + std::to_string(matrix.rows) + "x" + std::to_string(matrix.cols) + " instead.");
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    data[i][j] = matrix[i][j];
+        }
+
+        static constexpr SmallMatrix identity()
+        {
+            SmallMatrix result;
+            for (int i = 0; i < (R < C ? R : C); i++)
+                result.data[i][i] = 1;
+            return result;
+        }
+
+        // Accessors
+        constexpr void set(int row, int col, float value)
+        {
+            check_index(row, col);
+            data[row][col] = value;
+        }
+
+        constexpr float get(int row, int col) const
+        {
+            check_index(row, col);
+            return data[row][col];
+        }
+
+        constexpr float *operator[](int row) { return data[row]; } // unchecked
+        constexpr const float *operator[](int row) const { return data[row]; }
+
+        Matrix to_matrix() const
+        {
+            Matrix result(R, C);
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    result[i][j] = data[i][j];
+            return result;
+        }
+
+        // Implicit, so code written against Matrix keeps compiling, e.g.
+        // `Matrix m = Transform::scale(2, 2);`
+        operator Matrix() const { return to_matrix(); }
+
+        friend std::ostream &operator<<(std::ostream &os, const SmallMatrix &matrix)
+        {
+            return os << matrix.to_matrix();
+        }
+
+        // Element-wise operations
+        constexpr SmallMatrix operator+(const SmallMatrix &other) const
+        {
+            SmallMatrix result;
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    result.data[i][j] = data[i][j] + other.data[i][j];
+            return result;
+        }
+
+        constexpr SmallMatrix operator-(const SmallMatrix &other) const
+        {
+            SmallMatrix result;
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    result.data[i][j] = data[i][j] - other.data[i][j];
+            return result;
+        }
+
+        constexpr SmallMatrix operator*(float scalar) const
+        {
+            SmallMatrix result;
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    result.data[i][j] = data[i][j] * scalar;
+            return result;
+        }
+
+        constexpr SmallMatrix operator/(float scalar) const
+        {
+            SmallMatrix result;
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    result.data[i][j] = data[i][j] / scalar;
+            return result;
+        }
+
+        // Comparison
+        constexpr bool operator==(const SmallMatrix &other) const
+        {
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    if (data[i][j] != other.data[i][j])
+                        return false;
+            return true;
+        }
+
+        constexpr bool operator!=(const SmallMatrix &other) const
+        {
+            return !(*this == other);
+        }
+
+        constexpr bool is_close(const SmallMatrix &other, float tolerance = 1e-5) const
+        {
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                {
+                    float diff = data[i][j] - other.data[i][j];
+                    if (diff < -tolerance || diff > tolerance)
+                        return false;
+                }
+            return true;
+        }
+
+        // Matrix operations
+        template <int K>
+        constexpr SmallMatrix<R, K> operator*(const SmallMatrix<C, K> &other) const // matrix product
+        {
+            SmallMatrix<R, K> result;
+            for (int i = 0; i < R; i++)
+                for (int k = 0; k < C; k++)
+                    for (int j = 0; j < K; j++)
+                        result.data[i][j] += data[i][k] * other.data[k][j];
+            return result;
+        }
+
+        constexpr SmallMatrix<C, R> transpose() const
+        {
+            SmallMatrix<C, R> result;
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++)
+                    result.data[j][i] = data[i][j];
+            return result;
+        }
+
+        constexpr float det() const
+        {
+            static_assert(R == C, "Matrix must be square");
+            const auto &m = data;
+            if constexpr (R == 1)
+                return m[0][0];
+            else if constexpr (R == 2)
+                return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+            else if constexpr (R == 3)
+                return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+                       m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+                       m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+            else
+            {
+                // Gaussian elimination with partial pivoting
+                SmallMatrix u = *this;
+                float result = 1;
+                for (int k = 0; k < R; k++)
+                {
+                    int pivot = k;
+                    for (int i = k + 1; i < R; i++)
+                        if (abs(u.data[i][k]) > abs(u.data[pivot][k]))
+                            pivot = i;
+                    if (u.data[pivot][k] == 0)
+                        return 0;
+                    if (pivot != k)
+                    {
+                        for (int j = 0; j < R; j++)
+                        {
+                            float tmp = u.data[k][j];
+                            u.data[k][j] = u.data[pivot][j];
+                            u.data[pivot][j] = tmp;
+                        }
+                        result = -result;
+                    }
+                    result *= u.data[k][k];
+                    for (int i = k + 1; i < R; i++)
+                    {
+                        float factor = u.data[i][k] / u.data[k][k];
+                        for (int j = k; j < R; j++)
+                            u.data[i][j] -= factor * u.data[k][j];
+                    }
+                }
+                return result;
+            }
+        }
+
+        constexpr SmallMatrix inverse() const
+        {
+            static_assert(R == C, "Matrix must be square");
+            const auto &m = data;
+            if constexpr (R <= 3)
+            {
+                float d = det();
+                if (d == 0)
+                    throw std::invalid_argument("Matrix is not invertible");
+                SmallMatrix result;
+                if constexpr (R == 1)
+                    result.data[0][0] = 1 / d;
+                else if constexpr (R == 2)
+                    result = SmallMatrix{{m[1][1], -m[0][1]}, {-m[1][0], m[0][0]}} / d;
+                else
+                    result = SmallMatrix{{m[1][1] * m[2][2] - m[1][2] * m[2][1], m[0][2] * m[2][1] - m[0][1] * m[2][2], m[0][1] * m[1][2] - m[0][2] * m[1][1]},
+                                         {m[1][2] * m[2][0] - m[1][0] * m[2][2], m[0][0] * m[2][2] - m[0][2] * m[2][0], m[0][2] * m[1][0] - m[0][0] * m[1][2]},
+                                         {m[1][0] * m[2][1] - m[1][1] * m[2][0], m[0][1] * m[2][0] - m[0][0] * m[2][1], m[0][0] * m[1][1] - m[0][1] * m[1][0]}} /
+                             d;
+                return result;
+            }
+            else
+            {
+                // Gauss-Jordan elimination with partial pivoting
+                SmallMatrix a = *this;
+                SmallMatrix result = identity();
+                for (int k = 0; k < R; k++)
+                {
+                    int pivot = k;
+                    for (int i = k + 1; i < R; i++)
+                        if (abs(a.data[i][k]) > abs(a.data[pivot][k]))
+                            pivot = i;
+                    if (a.data[pivot][k] == 0)
+                        throw std::invalid_argument("Matrix is not invertible");
+                    for (int j = 0; j < R; j++)
+                    {
+                        float tmp = a.data[k][j];
+                        a.data[k][j] = a.data[pivot][j];
+                        a.data[pivot][j] = tmp;
+                        tmp = result.data[k][j];
+                        result.data[k][j] = result.data[pivot][j];
+                        result.data[pivot][j] = tmp;
+                    }
+                    float scale = 1 / a.data[k][k];
+                    for (int j = 0; j < R; j++)
+                    {
+                        a.data[k][j] *= scale;
+                        result.data[k][j] *= scale;
+                    }
+                    for (int i = 0; i < R; i++)
+                    {
+                        if (i == k)
+                            continue;
+                        float factor = a.data[i][k];
+                        for (int j = 0; j < R; j++)
+                        {
+                            a.data[i][j] -= factor * a.data[k][j];
+                            result.data[i][j] -= factor * result.data[k][j];
+                        }
+                    }
+                }
+                return result;
+            }
+        }
+
+    private:
+        static constexpr float abs(float value) { return value < 0 ? -value : value; }
+
+        constexpr void check_index(int row, int col) const
+        {
+            if (row < 0 || row >= R || col < 0 || col >= C)
+                throw std::out_of_range("Matrix index (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+        }
+    };
+
+    template <int R, int C>
+    constexpr SmallMatrix<R, C> operator*(float scalar, const SmallMatrix<R, C> &matrix)
+    {
+        return matrix * scalar;
+    }
+
+    // Column vector, e.g. a homogeneous point
+    template <int N>
+    using SmallVector = SmallMatrix<N, 1>;
+
+    using Matrix3 = SmallMatrix<3, 3>;
+    using Vector3 = SmallVector<3>;
+}
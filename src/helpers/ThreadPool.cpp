@@ -0,0 +1,129 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace VisualAlgo
+{
+    namespace
+    {
+        // State of one parallel_for, shared with the jobs queued for it. A job
+        // may only start after the loop is over, it then finds no index left.
+        struct Loop
+        {
+            const std::function<void(int)> *task;
+            int count;
+            std::atomic<int> next = 0;
+            int done = 0;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+
+        void run(Loop &loop)
+        {
+            int done = 0;
+            for (int i = loop.next++; i < loop.count; i = loop.next++, done++)
+            {
+                try
+                {
+                    (*loop.task)(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(loop.mutex);
+                    if (!loop.error)
+                        loop.error = std::current_exception();
+                }
+            }
+            if (done == 0)
+                return;
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            loop.done += done;
+            if (loop.done == loop.count)
+                loop.finished.notify_all();
+        }
+    }
+
+    ThreadPool::ThreadPool(int threads)
+    {
+        if (threads < 0)
+            throw std::invalid_argument("Threads must be non-negative. Got " + std::to_string(threads) + " instead.");
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        for (int t = 1; t < threads; t++)
+            this->workers.emplace_back(&ThreadPool::work, this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->wake.notify_all();
+        for (std::thread &worker : this->workers)
+            worker.join();
+    }
+
+    int ThreadPool::size() const
+    {
+        return this->workers.size() + 1;
+    }
+
+    void ThreadPool::parallel_for(int count, const std::function<void(int)> &task)
+    {
+        if (count <= 0)
+            return;
+        auto loop = std::make_shared<Loop>();
+        loop->task = &task;
+        loop->count = count;
+
+        const int helpers = std::min<int>(this->workers.size(), count - 1);
+        if (helpers > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                for (int h = 0; h < helpers; h++)
+                    this->jobs.emplace_back([loop]()
+                                            { run(*loop); });
+            }
+            this->wake.notify_all();
+        }
+
+        run(*loop);
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->finished.wait(lock, [&]()
+                            { return loop->done == loop->count; });
+        if (loop->error)
+            std::rethrow_exception(loop->error);
+    }
+
+    ThreadPool &ThreadPool::global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void ThreadPool::work()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->wake.wait(lock, [this]()
+                                { return this->stopping || !this->jobs.empty(); });
+                if (this->jobs.empty())
+                    return;
+                job = std::move(this->jobs.front());
+                this->jobs.pop_front();
+            }
+            job();
+        }
+    }
+}
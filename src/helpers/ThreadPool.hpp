@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VisualAlgo
+{
+    // A fixed set of worker threads for loops whose iterations are
+    // independent. The thread calling parallel_for works on the loop too, so
+    // loops may be nested and a pool of one thread runs them inline.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(int threads = 0); // 0: std::thread::hardware_concurrency()
+        ~ThreadPool();
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        int size() const; // threads working on a loop, the caller included
+
+        // Calls task(0), ..., task(count - 1) in any order and on any thread,
+        // and returns once all of them are done. The first exception thrown
+        // by a task is rethrown here once the other tasks are done.
+        void parallel_for(int count, const std::function<void(int)> &task);
+
+        static ThreadPool &global(); // shared by the algorithms of the library
+
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<std::function<void()>> jobs;
+        bool stopping = false;
+
+        void work();
+    };
+}
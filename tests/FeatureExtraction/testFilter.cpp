@@ -6,6 +6,8 @@
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <algorithm>
+#include <stdexcept>
 
 const float MAX_PROPORTION_ABS_DIFF = 0.05f;
 const float SIGMA = 3.0f;
@@ -43,6 +45,83 @@ namespace VisualAlgo::FeatureExtraction
         CHECK(test_gaussian_filter("lighthouse", SIGMA));
     }
 
+    // The recursive filter only approximates the Gaussian: from sigma = 3 on it
+    // stays within 2% of the sampled kernel, on a natural image, on noise and
+    // on images much smaller than the kernel
+    TEST(GaussianFilterTestSuite, GaussianFilterRecursiveMatchesKernel)
+    {
+        Matrix image;
+        image.load("datasets/FeatureExtraction/lighthouse_resized.ppm");
+        image.normalize();
+        Matrix noise = Matrix::random(61, 83, 0, 1);
+
+        for (float sigma : {3.0f, 8.0f, 12.0f, 25.0f, 40.0f, 100.0f})
+        {
+            GaussianFilter kernel(sigma, GaussianMethod::KERNEL), recursive(sigma, GaussianMethod::RECURSIVE);
+            for (BorderMode border : {BorderMode::REFLECT_101, BorderMode::REPLICATE, BorderMode::CONSTANT})
+            {
+                CHECK(recursive.apply(image, border).is_close(kernel.apply(image, border), 0.02f));
+                CHECK(recursive.apply(noise, border).is_close(kernel.apply(noise, border), 0.02f));
+            }
+
+            // Images smaller than the kernel are extended as far as it reaches
+            Matrix small = Matrix::random(16, 16, 0, 1);
+            for (BorderMode border : {BorderMode::REFLECT_101, BorderMode::REFLECT, BorderMode::WRAP, BorderMode::REPLICATE, BorderMode::CONSTANT})
+                CHECK(recursive.apply(small, border).is_close(kernel.apply(small, border), 0.02f));
+
+            // A flat image stays flat
+            Matrix flat(20, 30, 5);
+            CHECK(recursive.apply(flat).is_close(flat, 1e-4));
+            CHECK(recursive.apply(flat, BorderMode::CONSTANT, 5).is_close(flat, 1e-4));
+        }
+
+        bool exceptionThrown = false;
+        try
+        {
+            GaussianFilter(0.8f, GaussianMethod::RECURSIVE);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    // Constructing a recursive filter samples no kernel, whatever the sigma
+    TEST(GaussianFilterTestSuite, GaussianFilterRecursiveHasNoKernel)
+    {
+        int before = KernelCache::global().size();
+        GaussianFilter large(100.0f, GaussianMethod::AUTO);
+        CHECK(large.applied_method() == GaussianMethod::RECURSIVE);
+        CHECK(GaussianFilter(100.0f).applied_method() == GaussianMethod::KERNEL);
+        CHECK_EQUAL(before, KernelCache::global().size());
+
+        bool exceptionThrown = false;
+        try
+        {
+            large.taps();
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+        CHECK_EQUAL(7, GaussianFilter(1.0f).taps().cols);
+    }
+
+    // Element-wise expressions are evaluated before being filtered
+    TEST(FilterBorderTestSuite, FilterAppliesExpressions)
+    {
+        Matrix a = Matrix::random(20, 30, 0, 1), b = Matrix::random(20, 30, 0, 1);
+        Matrix product = a * b;
+        GaussianFilter gaussianFilter(2.0f);
+        CHECK(gaussianFilter.apply(a * b) == gaussianFilter.apply(product));
+        CHECK(gaussianFilter.apply(a * b, BorderMode::CONSTANT, 1) == gaussianFilter.apply(product, BorderMode::CONSTANT, 1));
+
+        const Filter &filter = gaussianFilter;
+        CHECK(filter.apply(a + b * 2) == gaussianFilter.apply(Matrix(a + b * 2)));
+    }
+
     TEST(MedianFilter, MedianFilterMatrix)
     {
         Matrix image = Matrix({{1, 2, 3, 4, 5},
@@ -61,4 +140,84 @@ namespace VisualAlgo::FeatureExtraction
         Matrix actual = medianFilter.apply(image);
         CHECK(actual.is_close(expected, 0.0001f));
     }
+
+    TEST(MedianFilter, MedianFilter8u)
+    {
+        // Same result as the float version, rounded
+        Matrix image = Matrix::random(23, 31, 0, 255);
+        for (int size : {1, 3, 5, 7})
+        {
+            MedianFilter medianFilter(size);
+            Matrix8u expected(medianFilter.apply(Matrix8u(image).to_matrix()));
+            CHECK(medianFilter.apply(Matrix8u(image)) == expected);
+        }
+    }
+
+    TEST(FilterBorderTestSuite, FilterBorderModes)
+    {
+        // A flat image stays flat unless the border brings in other values
+        Matrix image(12, 9, 5);
+        GaussianFilter gaussianFilter(1.0f);
+        for (BorderMode border : {BorderMode::REPLICATE, BorderMode::REFLECT, BorderMode::REFLECT_101, BorderMode::WRAP})
+            CHECK(gaussianFilter.apply(image, border).is_close(image, 1e-4));
+        Matrix zero_padded = gaussianFilter.apply(image, BorderMode::CONSTANT);
+        CHECK(zero_padded.get(0, 0) < 5 * 0.6f);
+        CHECK_DOUBLES_EQUAL(5, zero_padded.get(6, 4), 1e-4);
+        CHECK(gaussianFilter.apply(image, BorderMode::CONSTANT, 5).is_close(image, 1e-4));
+
+        // Every median window is full, so the border values take part
+        Matrix ramp({{1, 2, 3},
+                     {4, 5, 6},
+                     {7, 8, 9}});
+        MedianFilter medianFilter(3);
+        CHECK(medianFilter.apply(ramp, BorderMode::REPLICATE) == Matrix({{2, 3, 3},
+                                                                       {4, 5, 6},
+                                                                       {7, 7, 8}}));
+        CHECK(medianFilter.apply(ramp, BorderMode::CONSTANT, 0) == Matrix({{0, 2, 0},
+                                                                         {2, 5, 3},
+                                                                         {0, 5, 0}}));
+    }
+
+    TEST(MaxFilter, MaxFilterMatchesWindows)
+    {
+        Matrix image = Matrix::random(23, 17, -1, 1);
+        for (int size : {1, 3, 5, 7, 11, 29})
+        {
+            MaxFilter maxFilter(size);
+            Matrix actual = maxFilter.apply(image);
+            Matrix expected(image.rows, image.cols);
+            for (int i = 0; i < image.rows; i++)
+            {
+                for (int j = 0; j < image.cols; j++)
+                {
+                    float maximum = image[i][j];
+                    for (int r = std::max(0, i - size / 2); r <= std::min(image.rows - 1, i + size / 2); r++)
+                        for (int c = std::max(0, j - size / 2); c <= std::min(image.cols - 1, j + size / 2); c++)
+                            maximum = std::max(maximum, image[r][c]);
+                    expected[i][j] = maximum;
+                }
+            }
+            CHECK(actual == expected);
+        }
+
+        MaxFilter maxFilter(3);
+        Matrix ramp({{1, 2, 3},
+                     {4, 5, 6},
+                     {7, 8, 9}});
+        CHECK(maxFilter.apply(ramp, BorderMode::WRAP) == Matrix(3, 3, 9));
+        CHECK(maxFilter.apply(ramp, BorderMode::CONSTANT, 7.5f) == Matrix({{7.5f, 7.5f, 7.5f},
+                                                                          {8, 9, 9},
+                                                                          {8, 9, 9}}));
+
+        bool exceptionThrown = false;
+        try
+        {
+            MaxFilter evenFilter(4);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
 }
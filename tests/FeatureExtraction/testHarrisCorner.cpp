@@ -1,11 +1,18 @@
 #include "TestHarness.h"
 #include "helpers/Matrix.hpp"
 #include "FeatureExtraction/Harris.hpp"
+#include "FeatureExtraction/Gradients.hpp"
+#include "FeatureExtraction/Filter.hpp"
 #include "test_utils.hpp"
 
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <tuple>
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <vector>
 
 const float MAX_PROPORTION_ABS_DIFF = 0.05f;
 const float SIGMA = 1.0f;
@@ -33,6 +40,30 @@ static bool test_harris(std::string img_name, float sigma, float k, float thresh
     return (padet < MAX_PROPORTION_ABS_DIFF);
 }
 
+// The response of whole images, one step after the other
+static VisualAlgo::Matrix staged_response(const VisualAlgo::Matrix &image, float sigma, float k)
+{
+    using namespace VisualAlgo;
+    using namespace VisualAlgo::FeatureExtraction;
+    Matrix Ix = Gradients::computeXGradient(image);
+    Matrix Iy = Gradients::computeYGradient(image);
+    GaussianFilter g(sigma, GaussianMethod::AUTO);
+    Matrix Gxx = g.apply(Ix * Ix);
+    Matrix Gyy = g.apply(Iy * Iy);
+    Matrix Gxy = g.apply(Ix * Iy);
+    Matrix R(image.rows, image.cols);
+    for (int i = 0; i < image.rows; ++i)
+    {
+        for (int j = 0; j < image.cols; ++j)
+        {
+            float det = Gxx[i][j] * Gyy[i][j] - Gxy[i][j] * Gxy[i][j];
+            float trace = Gxx[i][j] + Gyy[i][j];
+            R[i][j] = det - k * trace * trace;
+        }
+    }
+    return R;
+}
+
 namespace VisualAlgo::FeatureExtraction
 {
     TEST(HarrisTestSuite, HarrisCat)
@@ -44,4 +75,144 @@ namespace VisualAlgo::FeatureExtraction
     {
         CHECK(test_harris("lighthouse", SIGMA, K, THRESHOLD));
     }
+
+    // The fused kernel gives the same response, to the last bit, as filtering
+    // whole images, also where the windows reflect off the borders
+    TEST(HarrisTestSuite, HarrisFusedMatchesStaged)
+    {
+        Matrix image;
+        image.load("datasets/FeatureExtraction/cat_resized.ppm");
+        image.normalize();
+        CHECK(Harris::response(image, SIGMA, K) == staged_response(image, SIGMA, K));
+
+        for (auto [rows, cols] : std::vector<std::pair<int, int>>{{1, 9}, {3, 2}, {5, 40}, {37, 23}})
+        {
+            Matrix small = Matrix::random(rows, cols, 0, 1);
+            for (float sigma : {0.5f, 1.0f, 2.5f, 12.0f})
+                CHECK(Harris::response(small, sigma, K) == staged_response(small, sigma, K));
+        }
+    }
+
+    TEST(HarrisTestSuite, HarrisStreamingDetect)
+    {
+        Matrix image;
+        image.load("datasets/FeatureExtraction/lighthouse_resized.ppm");
+        image.normalize();
+
+        Matrix R = Harris::response(image, SIGMA, K);
+        std::vector<std::tuple<int, int, float>> streamed;
+        Harris::detect(image, SIGMA, K, THRESHOLD, [&](int i, int j, float response)
+                       { streamed.push_back({i, j, response}); });
+        std::vector<std::pair<int, int>> corners = Harris::detect(image, SIGMA, K, THRESHOLD);
+
+        CHECK(!corners.empty());
+        CHECK_EQUAL((int)corners.size(), (int)streamed.size());
+        for (size_t n = 0; n < corners.size(); ++n)
+        {
+            auto [i, j, response] = streamed[n];
+            CHECK(corners[n] == std::make_pair(i, j));
+            CHECK(response == R[i][j] && response > THRESHOLD);
+        }
+    }
+
+    // Without a selection every pixel above the threshold is kept, strongest first
+    TEST(HarrisTestSuite, HarrisStrongestKeepsAll)
+    {
+        Matrix image;
+        image.load("datasets/FeatureExtraction/cat_resized.ppm");
+        image.normalize();
+
+        std::vector<std::tuple<int, int, float>> strongest = Harris::detect_strongest(image, SIGMA, K, THRESHOLD, CornerSelection());
+        std::vector<std::pair<int, int>> corners = Harris::detect(image, SIGMA, K, THRESHOLD);
+        CHECK_EQUAL((int)corners.size(), (int)strongest.size());
+
+        std::vector<std::pair<int, int>> positions;
+        for (size_t n = 0; n < strongest.size(); ++n)
+        {
+            positions.push_back({std::get<0>(strongest[n]), std::get<1>(strongest[n])});
+            if (n > 0)
+                CHECK(std::get<2>(strongest[n - 1]) >= std::get<2>(strongest[n]));
+        }
+        std::sort(positions.begin(), positions.end());
+        CHECK(positions == corners);
+    }
+
+    TEST(HarrisTestSuite, HarrisStrongestSelection)
+    {
+        Matrix image;
+        image.load("datasets/FeatureExtraction/lighthouse_resized.ppm");
+        image.normalize();
+        Matrix R = Harris::response(image, SIGMA, K);
+
+        // Local maxima: no pixel of the window is stronger, and none is missed
+        CornerSelection selection;
+        selection.window_size = 5;
+        std::vector<std::tuple<int, int, float>> maxima = Harris::detect_strongest(image, SIGMA, K, THRESHOLD, selection);
+        std::vector<std::tuple<int, int, float>> expected;
+        for (int i = 0; i < R.rows; ++i)
+        {
+            for (int j = 0; j < R.cols; ++j)
+            {
+                bool is_maximum = R[i][j] > THRESHOLD;
+                for (int r = std::max(0, i - 2); r <= std::min(R.rows - 1, i + 2); ++r)
+                    for (int c = std::max(0, j - 2); c <= std::min(R.cols - 1, j + 2); ++c)
+                        is_maximum = is_maximum && !(R[r][c] > R[i][j]);
+                if (is_maximum)
+                    expected.push_back({i, j, R[i][j]});
+            }
+        }
+        std::sort(expected.begin(), expected.end(), [](const auto &a, const auto &b)
+                  { return std::get<2>(a) != std::get<2>(b) ? std::get<2>(a) > std::get<2>(b) : a < b; });
+        CHECK(!maxima.empty());
+        CHECK(maxima == expected);
+
+        std::vector<std::tuple<int, int, float>> all_maxima = expected;
+
+        // The strongest corners overall are the first ones of all the maxima
+        selection.max_corners = 10;
+        std::vector<std::tuple<int, int, float>> top = Harris::detect_strongest(image, SIGMA, K, THRESHOLD, selection);
+        expected.resize(10);
+        CHECK(top == expected);
+
+        // Cells keep their strongest maxima, the weaker ones are only dropped from full cells
+        selection.max_corners = 0;
+        selection.cell_size = 32;
+        selection.max_per_cell = 2;
+        std::vector<std::tuple<int, int, float>> bucketed = Harris::detect_strongest(image, SIGMA, K, THRESHOLD, selection);
+        std::map<std::pair<int, int>, std::vector<float>> cells;
+        for (auto [i, j, response] : all_maxima)
+            cells[{i / 32, j / 32}].push_back(response);
+        int kept = 0;
+        for (auto &[cell, responses] : cells)
+            kept += std::min<int>(2, responses.size());
+        CHECK_EQUAL(kept, (int)bucketed.size());
+        for (auto [i, j, response] : bucketed)
+        {
+            const std::vector<float> &responses = cells[{i / 32, j / 32}];
+            CHECK(response >= responses[std::min<int>(1, responses.size() - 1)]);
+        }
+    }
+
+    TEST(HarrisTestSuite, HarrisInvalidSelection)
+    {
+        Matrix image = Matrix::random(8, 8, 0, 1);
+        CornerSelection even, cells, per_cell, corners;
+        even.window_size = 4;
+        cells.cell_size = -1;
+        per_cell.max_per_cell = 0;
+        corners.max_corners = -2;
+        for (const CornerSelection &selection : {even, cells, per_cell, corners})
+        {
+            bool exceptionThrown = false;
+            try
+            {
+                Harris::detect_strongest(image, SIGMA, K, THRESHOLD, selection);
+            }
+            catch (const std::invalid_argument &e)
+            {
+                exceptionThrown = true;
+            }
+            CHECK(exceptionThrown);
+        }
+    }
 }
@@ -0,0 +1,226 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "FeatureExtraction/ScaleSpace.hpp"
+#include "FeatureExtraction/Filter.hpp"
+#include "FeatureExtraction/Blob.hpp"
+#include "helpers/ThreadPool.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace VisualAlgo::FeatureExtraction
+{
+    TEST(ScaleSpaceTestSuite, ScaleSpaceFactors)
+    {
+        Matrix image = Matrix::random(200, 300, 0, 1);
+        ScaleSpace space(image, {1, 3.2f, 6.4f, 100});
+        CHECK_EQUAL(4, space.size());
+        CHECK_EQUAL(1, space.factor(0));
+        CHECK_EQUAL(2, space.factor(1));
+        CHECK_EQUAL(4, space.factor(2));
+        CHECK_EQUAL(8, space.factor(3)); // 200 / 16 rows would be too small
+        CHECK_EQUAL(100, space.gaussian(1).rows);
+        CHECK_EQUAL(150, space.gaussian(1).cols);
+        CHECK_EQUAL(25, space.gaussian(3).rows);
+        CHECK_EQUAL(200, space.gaussian(3, 1).rows);
+
+        ScaleSpace full(image, {1, 3.2f, 6.4f, 100}, false);
+        CHECK_EQUAL(1, full.factor(3));
+    }
+
+    // Incremental blurs and downsampled levels stay close to blurring the
+    // image from scratch
+    TEST(ScaleSpaceTestSuite, ScaleSpaceMatchesGaussianFilter)
+    {
+        Matrix image;
+        image.load("datasets/FeatureExtraction/cat_resized.ppm");
+        image.normalize();
+
+        std::vector<float> sigmas{2, 2.5f, 3.2f, 4, 7};
+        ScaleSpace space(image, sigmas);
+        for (int level = 0; level < space.size(); level++)
+        {
+            const int factor = space.factor(level);
+            Matrix expected = GaussianFilter(sigmas[level]).apply(image);
+            const Matrix &gaussian = space.gaussian(level);
+            Matrix decimated(gaussian.rows, gaussian.cols);
+            for (int i = 0; i < gaussian.rows; i++)
+                for (int j = 0; j < gaussian.cols; j++)
+                    decimated[i][j] = expected[i * factor][j * factor];
+            CHECK(gaussian.is_close(decimated, 0.02));
+        }
+
+        Matrix dog = space.dog(3);
+        CHECK_EQUAL(space.dog_factor(3), 2);
+        CHECK(dog == space.gaussian(4, 2) - space.gaussian(3, 2));
+    }
+
+    // Each level adds blur to the next smaller one, whatever the order the
+    // levels are requested in. Bands of rows blurred apart give the same
+    // values as blurring the level whole.
+    TEST(ScaleSpaceTestSuite, ScaleSpaceIncrementalLevels)
+    {
+        Matrix image = Matrix::random(300, 70, 0, 1);
+        ScaleSpace space(image, {5, 2, 3}, false), reversed(image, {5, 2, 3}, false);
+        CHECK(reversed.gaussian(0) == space.gaussian(0));
+        CHECK(space.gaussian(1) == GaussianFilter(2).apply(image));
+        CHECK(space.gaussian(2) == GaussianFilter(std::sqrt(5.0f)).apply(space.gaussian(1)));
+        CHECK(space.gaussian(0) == GaussianFilter(4).apply(space.gaussian(2)));
+        CHECK(reversed.gaussian(1) == space.gaussian(1));
+    }
+
+    // Levels blurred on several threads are the levels blurred one by one
+    TEST(ScaleSpaceTestSuite, ScaleSpaceConcurrentLevels)
+    {
+        Matrix image = Matrix::random(96, 128, 0, 1);
+        std::vector<float> sigmas{1.6f, 2, 2.5f, 3.2f, 4, 5, 6.4f, 8};
+        ScaleSpace sequential(image, sigmas), concurrent(image, sigmas);
+        ThreadPool pool(4);
+        pool.parallel_for(2 * sigmas.size(), [&](int n)
+                          { concurrent.gaussian(n % sigmas.size()); });
+        for (int level = 0; level < sequential.size(); level++)
+            CHECK(sequential.gaussian(level) == concurrent.gaussian(level));
+    }
+
+    // The Laplacian of a paraboloid is the same constant at every scale and
+    // resolution, in pixels of the image
+    TEST(ScaleSpaceTestSuite, ScaleSpaceLaplacian)
+    {
+        Matrix image(64, 64);
+        for (int i = 0; i < 64; i++)
+            for (int j = 0; j < 64; j++)
+                image[i][j] = (i - 32) * (i - 32) + (j - 32) * (j - 32);
+
+        ScaleSpace space(image, {1, 4});
+        for (int level = 0; level < space.size(); level++)
+        {
+            Matrix laplacian = space.laplacian(level);
+            const int margin = 24 / space.factor(level);
+            CHECK(laplacian.submatrix(margin, laplacian.rows - margin, margin, laplacian.cols - margin).is_close(Matrix(laplacian.rows - 2 * margin, laplacian.cols - 2 * margin, 4), 0.05));
+        }
+    }
+
+    TEST(ScaleSpaceTestSuite, ScaleSpaceInvalidArguments)
+    {
+        Matrix image = Matrix::random(40, 40, 0, 1);
+        bool exceptionThrown = false;
+        try
+        {
+            ScaleSpace space(image, {1, 0});
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+
+        ScaleSpace space(image, {1, 4});
+        exceptionThrown = false;
+        try
+        {
+            space.gaussian(0, 2); // finer than 1.6 pixels once halved
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+
+        exceptionThrown = false;
+        try
+        {
+            space.dog(1);
+        }
+        catch (const std::out_of_range &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    // Both detectors find two Gaussian blobs, through levels at several resolutions
+    TEST(ScaleSpaceTestSuite, BlobDetectorsFindSyntheticBlobs)
+    {
+        Matrix image(128, 128);
+        for (int i = 0; i < 128; i++)
+            for (int j = 0; j < 128; j++)
+                image[i][j] = std::exp(-((i - 40) * (i - 40) + (j - 70) * (j - 70)) / 72.0f) +
+                              0.5f * std::exp(-((i - 95) * (i - 95) + (j - 30) * (j - 30)) / 8.0f);
+
+        auto found = [](const std::vector<std::tuple<int, int, float>> &blobs, int row, int col)
+        {
+            for (auto [i, j, sigma] : blobs)
+                if (std::abs(i - row) <= 2 && std::abs(j - col) <= 2)
+                    return true;
+            return false;
+        };
+
+        std::vector<std::tuple<int, int, float>> log_blobs = BlobLoG(2, 1.26f, 0.05f, 3, 10).detect(image);
+        CHECK(found(log_blobs, 40, 70));
+        CHECK(found(log_blobs, 95, 30));
+
+        // k < 1: the scales decrease, and bright blobs give positive differences
+        std::vector<std::tuple<int, int, float>> dog_blobs = BlobDoG(16, 0.8f, 0.01f, 3, 10).detect(image);
+        CHECK(found(dog_blobs, 40, 70));
+        CHECK(found(dog_blobs, 95, 30));
+    }
+
+    // Exposes the non-maximum suppression of the detectors
+    class BlobMaxima : public Blob
+    {
+    public:
+        Matrix apply(const Matrix &image) const override { return image; }
+        std::vector<std::tuple<int, int, float>> detect(const Matrix &) const override { return {}; }
+        using Blob::findLocalMaxima;
+    };
+
+    // The maximum filters find the same maxima as comparing every point with
+    // its whole neighborhood
+    TEST(ScaleSpaceTestSuite, LocalMaximaMatchNeighborhoods)
+    {
+        std::vector<int> factors{1, 1, 2, 2, 4};
+        std::vector<float> sigmas{1, 2, 3, 4, 5};
+        std::vector<Matrix> scale_space;
+        for (int factor : factors)
+        {
+            // Levels of several bands of rows, and few distinct values so that there are ties
+            Matrix level = Matrix::random(160 / factor, 40 / factor, 0, 8);
+            for (int i = 0; i < level.rows; i++)
+                for (int j = 0; j < level.cols; j++)
+                    level[i][j] = std::floor(level[i][j]);
+            scale_space.push_back(level);
+        }
+
+        for (int window_size : {1, 3, 5, 7})
+        {
+            const int half_window = window_size / 2;
+            std::vector<std::tuple<int, int, float>> expected;
+            for (int n = 0; n < (int)scale_space.size(); n++)
+            {
+                const Matrix &level = scale_space[n];
+                const int scale_window = std::min(half_window, std::min(n, (int)scale_space.size() - n - 1));
+                for (int i = half_window; i < level.rows - half_window; i++)
+                {
+                    for (int j = half_window; j < level.cols - half_window; j++)
+                    {
+                        bool is_maximum = level[i][j] > 4;
+                        for (int s = n - scale_window; s <= n + scale_window; s++)
+                        {
+                            const Matrix &neighbor = scale_space[s];
+                            for (int x = i - half_window; x <= i + half_window; x++)
+                                for (int y = j - half_window; y <= j + half_window; y++)
+                                    if (neighbor[std::min(x * factors[n] / factors[s], neighbor.rows - 1)][std::min(y * factors[n] / factors[s], neighbor.cols - 1)] > level[i][j])
+                                        is_maximum = false;
+                        }
+                        if (is_maximum)
+                            expected.push_back(std::make_tuple(i * factors[n], j * factors[n], sigmas[n]));
+                    }
+                }
+            }
+            CHECK(BlobMaxima().findLocalMaxima(scale_space, factors, sigmas, window_size, 4) == expected);
+        }
+    }
+}
@@ -121,4 +121,16 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         CHECK(correlation > MIN_CORRELATION);
     }
 
-}
\ No newline at end of file
+
+    TEST(HistogramEqualizationTestSuite, LighthouseDark8u)
+    {
+        Matrix8u image;
+        image.load("datasets/ImagePreprocessingAndEnhancement/lighthouse_dark.ppm");
+        Matrix8u actual = HistogramEqualization::equalize(image);
+
+        // Same result as the float version, rounded
+        Matrix8u expected(HistogramEqualization::equalize(image.to_matrix()));
+        CHECK(actual == expected);
+    }
+
+}
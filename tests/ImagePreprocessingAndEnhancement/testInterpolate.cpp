@@ -152,4 +152,22 @@ namespace VisualAlgo::ImagePreprocessingAndEnhancement
         });
         CHECK(m2i_actual.is_close(m2i_expected, 0.01));
     }
+
+    TEST(InterpolationTestSuite, InterpolationBorderModes)
+    {
+        Matrix m1 = Matrix({{0, 1, 2},
+                            {1, 2, 3},
+                            {2, 3, 4}});
+        CHECK_EQUAL(0, Interpolate::nearest(m1, -1, 0));
+        CHECK_EQUAL(1, Interpolate::nearest(m1, -1, 0, BorderMode::REFLECT_101));
+        CHECK_EQUAL(0, Interpolate::nearest(m1, 3.2, 0, BorderMode::WRAP));
+        CHECK_EQUAL(7, Interpolate::nearest(m1, 3.2, 0, BorderMode::CONSTANT, 7));
+        CHECK_DOUBLES_EQUAL(5, Interpolate::bilinear(m1, -0.5, 0, BorderMode::CONSTANT, 10), 0.0001);
+        CHECK_DOUBLES_EQUAL(2, Interpolate::bilinear(m1, 2.5, 0, BorderMode::REFLECT), 0.0001);
+        CHECK_DOUBLES_EQUAL(1, Interpolate::bicubic(m1, 1, 0, BorderMode::WRAP), 0.0001);
+
+        // Interior samples do not depend on the border
+        Matrix m2 = Matrix::random(6, 7, 0, 1);
+        CHECK_DOUBLES_EQUAL(Interpolate::bicubic(m2, 3.3, 2.6), Interpolate::bicubic(m2, 3.3, 2.6, BorderMode::CONSTANT), 1e-6);
+    }
 }
@@ -34,4 +34,13 @@ namespace VisualAlgo::SegmentationAndGrouping
         CHECK_EQUAL(image.rows, actual.rows);
         CHECK_EQUAL(image.cols, actual.cols);
     }
-}
\ No newline at end of file
+
+    TEST(ThresholdingTestSuite, ThresholdingMask)
+    {
+        Matrix image({{10, 200}, {130, 131}});
+        Matrix8u mask = Thresholding::mask(image, 130);
+        CHECK(mask == Matrix8u({{0, 255}, {0, 255}}));
+        CHECK(mask.to_matrix() == Thresholding::apply(image, 130));
+        CHECK_EQUAL(sizeof(uint8_t), sizeof(mask.data[0]));
+    }
+}
@@ -0,0 +1,70 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/BasicMatrix.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace VisualAlgo
+{
+    TEST(BasicMatrixTestSuite, BasicMatrixConstructors)
+    {
+        Matrix8u m(2, 3, 7);
+        CHECK_EQUAL(2, m.rows);
+        CHECK_EQUAL(3, m.cols);
+        CHECK_EQUAL(3, m.stride);
+        CHECK_EQUAL(6, static_cast<int>(m.data.size()));
+        CHECK_EQUAL(7, m.get(1, 2));
+
+        Matrix16u n({{1, 2}, {3, 60000}});
+        CHECK_EQUAL(60000, n[1][1]);
+        CHECK_EQUAL(60000, n.max());
+        CHECK_EQUAL(1, n.min());
+
+        bool exceptionThrown = false;
+        try
+        {
+            m.get(2, 0);
+        }
+        catch (const std::out_of_range &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK_EQUAL(true, exceptionThrown);
+    }
+
+    TEST(BasicMatrixTestSuite, BasicMatrixConversions)
+    {
+        // Rounds half away from zero and saturates
+        Matrix m({{-3, 0.4f, 0.5f}, {254.5f, 300, 127.49f}});
+        Matrix8u m8(m);
+        CHECK(m8 == Matrix8u({{0, 0, 1}, {255, 255, 127}}));
+        CHECK(m8.to_matrix() == Matrix({{0, 0, 1}, {255, 255, 127}}));
+
+        Matrix16u m16(m);
+        CHECK(m16 == Matrix16u({{0, 0, 1}, {255, 300, 127}}));
+        CHECK(m16.convert<uint8_t>() == m8);
+
+        Matrix64f m64(m);
+        CHECK_DOUBLES_EQUAL(127.49, m64.get(1, 2), 1e-4);
+        CHECK(m64.to_matrix() == m);
+
+        // Conversion also works on a view
+        Matrix8u tile(m.view(1, 2, 0, 2));
+        CHECK(tile == Matrix8u({{255, 255}}));
+    }
+
+    TEST(BasicMatrixTestSuite, BasicMatrixLoadSave)
+    {
+        Matrix image;
+        image.load("datasets/ImagePreprocessingAndEnhancement/lighthouse_dark.ppm");
+        Matrix8u image8;
+        image8.load("datasets/ImagePreprocessingAndEnhancement/lighthouse_dark.ppm");
+        CHECK(image8 == Matrix8u(image));
+
+        image8.save("results/helpers/matrix/basic_matrix_8u.ppm");
+        Matrix8u reloaded;
+        reloaded.load("results/helpers/matrix/basic_matrix_8u.ppm");
+        CHECK(reloaded == image8);
+    }
+}
@@ -0,0 +1,69 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/Border.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace VisualAlgo
+{
+    // Indices -3 .. 10 of a row of 8 pixels, abcdefgh
+    static std::vector<int> extended_row(BorderMode border)
+    {
+        std::vector<int> result;
+        for (int i = -3; i < 11; i++)
+            result.push_back(border_index(i, 8, border));
+        return result;
+    }
+
+    TEST(BorderTestSuite, BorderIndex)
+    {
+        CHECK(extended_row(BorderMode::CONSTANT) == std::vector<int>({-1, -1, -1, 0, 1, 2, 3, 4, 5, 6, 7, -1, -1, -1}));
+        CHECK(extended_row(BorderMode::REPLICATE) == std::vector<int>({0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 7, 7, 7}));
+        CHECK(extended_row(BorderMode::REFLECT) == std::vector<int>({2, 1, 0, 0, 1, 2, 3, 4, 5, 6, 7, 7, 6, 5}));
+        CHECK(extended_row(BorderMode::REFLECT_101) == std::vector<int>({3, 2, 1, 0, 1, 2, 3, 4, 5, 6, 7, 6, 5, 4}));
+        CHECK(extended_row(BorderMode::WRAP) == std::vector<int>({5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2}));
+
+        // Farther than the size of the image
+        CHECK_EQUAL(1, border_index(-5, 3, BorderMode::REFLECT));
+        CHECK_EQUAL(1, border_index(-5, 3, BorderMode::REFLECT_101));
+        CHECK_EQUAL(0, border_index(7, 1, BorderMode::REFLECT_101));
+        CHECK_EQUAL(2, border_index(-10, 3, BorderMode::WRAP));
+
+        bool exceptionThrown = false;
+        try
+        {
+            border_index(-1, 0, BorderMode::REPLICATE);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    TEST(BorderTestSuite, BorderPad)
+    {
+        Matrix m({{1, 2, 3},
+                  {4, 5, 6}});
+
+        CHECK(m.view().pad(1, 0, 2, 1, BorderMode::CONSTANT, 9) == Matrix({{9, 9, 9, 9, 9, 9},
+                                                                            {9, 9, 1, 2, 3, 9},
+                                                                            {9, 9, 4, 5, 6, 9}}));
+        CHECK(m.view().pad(1, 1, 1, 1, BorderMode::REPLICATE) == Matrix({{1, 1, 2, 3, 3},
+                                                                         {1, 1, 2, 3, 3},
+                                                                         {4, 4, 5, 6, 6},
+                                                                         {4, 4, 5, 6, 6}}));
+        CHECK(m.view().pad(0, 1, 2, 0, BorderMode::REFLECT_101) == Matrix({{3, 2, 1, 2, 3},
+                                                                           {6, 5, 4, 5, 6},
+                                                                           {3, 2, 1, 2, 3}}));
+        CHECK(m.view().pad(0, 0, 1, 2, BorderMode::WRAP) == Matrix({{3, 1, 2, 3, 1, 2},
+                                                                    {6, 4, 5, 6, 4, 5}}));
+
+        // Pads a view without touching the rest of the matrix
+        Matrix big({{1, 2, 3, 4},
+                    {5, 6, 7, 8}});
+        CHECK(big.view(0, 2, 1, 3).pad(0, 0, 1, 1, BorderMode::REFLECT) == Matrix({{2, 2, 3, 3},
+                                                                                    {6, 6, 7, 7}}));
+    }
+}
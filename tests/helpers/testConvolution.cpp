@@ -0,0 +1,110 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/Convolution.hpp"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace VisualAlgo
+{
+    TEST(ConvolutionTestSuite, ChooseMethod)
+    {
+        using Convolution::Method;
+        Matrix u = Matrix::random(9, 1, -1, 1), v = Matrix::random(1, 9, -1, 1);
+        CHECK(Convolution::choose_method(u.matmul(v), 1) == Method::SEPARABLE);
+        CHECK(Convolution::choose_method(u.matmul(v), 2) == Method::DIRECT);
+        CHECK(Convolution::choose_method(Matrix({{1, 0, -1}, {2, 0, -2}, {1, 0, -1}}), 1) == Method::DIRECT);
+        CHECK(Convolution::choose_method(Matrix::random(3, 3, -1, 1), 1) == Method::DIRECT);
+        CHECK(Convolution::choose_method(Matrix::random(1, 31, -1, 1), 1) == Method::DIRECT);
+        CHECK(Convolution::choose_method(Matrix::random(15, 15, -1, 1), 1) == Method::DIRECT);
+        CHECK(Convolution::choose_method(Matrix::random(31, 31, -1, 1), 1) == Method::FFT);
+        CHECK(Convolution::choose_method(Matrix::random(31, 31, -1, 1), 2) == Method::DIRECT);
+        CHECK_EQUAL("fft", Convolution::to_string(Method::FFT));
+        CHECK_EQUAL("gemm", Convolution::to_string(Method::GEMM));
+
+        // Only large banks of mid-size kernels go through GEMM
+        std::vector<Matrix> bank(Convolution::GEMM_MIN_KERNELS, Matrix::random(9, 9, -1, 1));
+        std::vector<MatrixView> views(bank.begin(), bank.end());
+        CHECK(Convolution::choose_method(views, 1) == Method::GEMM);
+        CHECK(Convolution::choose_method(views, 2) == Method::DIRECT);
+        views.pop_back();
+        CHECK(Convolution::choose_method(views, 1) == Method::DIRECT);
+    }
+
+    // Every method agrees with the direct one, including FFT tiles that do
+    // not divide the image and kernels as large as the image
+    TEST(ConvolutionTestSuite, MethodsAgree)
+    {
+        using Convolution::Method;
+        Matrix m = Matrix::random(301, 283, -1, 1);
+        for (auto [kernel_rows, kernel_cols] : {std::pair{2, 3}, {3, 3}, {5, 5}, {11, 11}, {15, 21}, {36, 36}, {64, 19}})
+        {
+            Matrix kernel = Matrix::random(kernel_rows, kernel_cols, -1, 1);
+            Matrix direct = Convolution::correlate_valid(m, kernel, 1, Method::DIRECT);
+            CHECK(Convolution::correlate_valid(m, kernel, 1, Method::FFT).is_close(direct, 1e-4));
+            CHECK(Convolution::correlate_valid(m, kernel, 1, Method::GEMM).is_close(direct, 1e-4));
+            CHECK(Convolution::correlate_valid(m, kernel, 1, Method::AUTO).is_close(direct, 1e-4));
+        }
+
+        // GEMM takes any stride, and a band of output rows that does not
+        // divide the output
+        std::vector<Matrix> bank;
+        for (int n = 0; n < 5; n++)
+            bank.push_back(Matrix::random(7, 4, -1, 1));
+        std::vector<MatrixView> kernels(bank.begin(), bank.end());
+        for (int stride : {1, 2, 3})
+        {
+            std::vector<Matrix> direct = Convolution::correlate_valid(m, kernels, stride, Method::DIRECT);
+            std::vector<Matrix> gemm = Convolution::correlate_valid(m, kernels, stride, Method::GEMM);
+            CHECK_EQUAL(5, (int)gemm.size());
+            for (int n = 0; n < 5; n++)
+                CHECK(gemm[n].is_close(direct[n], 1e-4));
+        }
+        Matrix large = Matrix::random(601, 700, -1, 1);
+        Matrix kernel = Matrix::random(25, 25, -1, 1);
+        CHECK(Convolution::correlate_valid(large, kernel, 1, Method::GEMM).is_close(Convolution::correlate_valid(large, kernel, 1, Method::DIRECT), 1e-3));
+
+        Matrix small = Matrix::random(20, 17, -1, 1);
+        Matrix whole = Matrix::random(20, 17, -1, 1);
+        CHECK(Convolution::correlate_valid(small, whole, 1, Method::FFT).is_close(Convolution::correlate_valid(small, whole, 1, Method::DIRECT), 1e-4));
+
+        Matrix u = Matrix::random(13, 1, -1, 1), v = Matrix::random(1, 7, -1, 1);
+        Matrix separable = u.matmul(v);
+        for (BorderMode border : {BorderMode::CONSTANT, BorderMode::REPLICATE, BorderMode::REFLECT, BorderMode::REFLECT_101, BorderMode::WRAP})
+        {
+            Matrix direct = Convolution::cross_correlate(m, separable, border, 0.5f, Method::DIRECT);
+            CHECK(direct.rows == m.rows && direct.cols == m.cols);
+            CHECK(Convolution::cross_correlate(m, separable, border, 0.5f, Method::SEPARABLE).is_close(direct, 1e-4));
+            CHECK(Convolution::cross_correlate(m, separable, border, 0.5f, Method::FFT).is_close(direct, 1e-4));
+        }
+    }
+
+    TEST(ConvolutionTestSuite, InvalidMethods)
+    {
+        using Convolution::Method;
+        Matrix m = Matrix::random(30, 30, -1, 1);
+
+        bool exceptionThrown = false;
+        try
+        {
+            Convolution::correlate_valid(m, Matrix::random(3, 3, -1, 1), 1, Method::SEPARABLE);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+
+        exceptionThrown = false;
+        try
+        {
+            Convolution::correlate_valid(m, Matrix::random(15, 15, -1, 1), 2, Method::FFT);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+}
@@ -0,0 +1,132 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/ConvolutionPlanner.hpp"
+#include "helpers/FilterBank.hpp"
+
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace VisualAlgo
+{
+    // A key is measured once and its output matches the direct method
+    TEST(ConvolutionPlannerTestSuite, PlannerRemembersKeys)
+    {
+        using Convolution::Method;
+        Convolution::Planner planner;
+        Matrix m = Matrix::random(120, 97, -1, 1);
+        Matrix kernel = Matrix::random(9, 7, -1, 1);
+        Matrix u = Matrix::random(5, 1, -1, 1), v = Matrix::random(1, 5, -1, 1);
+        Matrix separable = u.matmul(v);
+
+        CHECK_EQUAL(0, planner.size());
+        Matrix direct = Convolution::cross_correlate(m, kernel, BorderMode::REFLECT, 0, Method::DIRECT);
+        CHECK(planner.cross_correlate(m, kernel, BorderMode::REFLECT).is_close(direct, 1e-4));
+        CHECK_EQUAL(1, planner.size());
+        CHECK(planner.cross_correlate(m, kernel, BorderMode::REFLECT).is_close(direct, 1e-4));
+        CHECK_EQUAL(1, planner.size());
+
+        // Another border, another bank size or a separable kernel is a new key
+        planner.cross_correlate(m, kernel, BorderMode::CONSTANT, 0.5f);
+        Matrix flipped = kernel.flip();
+        std::vector<MatrixView> bank{kernel, flipped};
+        std::vector<Matrix> outputs = planner.cross_correlate(m, bank);
+        CHECK_EQUAL(2, (int)outputs.size());
+        CHECK(outputs[1].is_close(Convolution::cross_correlate(m, flipped, BorderMode::REFLECT_101, 0, Method::DIRECT), 1e-4));
+        planner.cross_correlate(m, separable);
+        CHECK_EQUAL(4, planner.size());
+        CHECK(planner.find(Convolution::Planner::key(m, {separable}, BorderMode::REFLECT_101)).has_value());
+        CHECK(!planner.find(Convolution::Planner::key(m, {separable}, BorderMode::WRAP)).has_value());
+
+        // Separability given by the caller is trusted, no SEPARABLE plan then
+        CHECK(Convolution::Planner::key(m, {separable}, BorderMode::REFLECT_101, true).separable);
+        CHECK(!Convolution::Planner::key(m, {separable}, BorderMode::REFLECT_101, false).separable);
+        CHECK(planner.cross_correlate(m, separable, BorderMode::REFLECT_101, 0, false).is_close(Convolution::cross_correlate(m, separable, BorderMode::REFLECT_101, 0, Method::DIRECT), 1e-4));
+        CHECK_EQUAL(5, planner.size());
+        CHECK(planner.find(Convolution::Planner::key(m, {separable}, BorderMode::REFLECT_101, false)) != Method::SEPARABLE);
+
+        // A plan set by hand is used as is
+        Convolution::PlanKey key = Convolution::Planner::key(m, {kernel}, BorderMode::WRAP);
+        planner.set(key, Method::FFT);
+        CHECK(planner.find(key) == Method::FFT);
+        CHECK(planner.cross_correlate(m, kernel, BorderMode::WRAP).is_close(Convolution::cross_correlate(m, kernel, BorderMode::WRAP, 0, Method::DIRECT), 1e-4));
+
+        bool exceptionThrown = false;
+        try
+        {
+            planner.set(key, Method::SEPARABLE);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    TEST(ConvolutionPlannerTestSuite, PlannerSaveLoad)
+    {
+        using Convolution::Method;
+        Convolution::Planner planner;
+        Matrix m = Matrix::random(64, 80, -1, 1);
+        Matrix kernel = Matrix::random(3, 3, -1, 1);
+        planner.cross_correlate(m, kernel);
+        Convolution::PlanKey key = Convolution::Planner::key(Matrix(512, 512), {Matrix::random(15, 15, -1, 1)}, BorderMode::REPLICATE);
+        planner.set(key, Method::GEMM);
+        planner.save("results/helpers/matrix/convolution_plans.txt");
+
+        Convolution::Planner loaded;
+        loaded.load("results/helpers/matrix/convolution_plans.txt");
+        CHECK_EQUAL(2, loaded.size());
+        CHECK(loaded.find(key) == Method::GEMM);
+        CHECK(loaded.find(Convolution::Planner::key(m, {kernel}, BorderMode::REFLECT_101)) == planner.find(Convolution::Planner::key(m, {kernel}, BorderMode::REFLECT_101)));
+
+        // A malformed file leaves the plans untouched
+        {
+            std::ofstream file("results/helpers/matrix/convolution_plans_invalid.txt");
+            file << "64 80 3 3 1 reflect_101 0 direct\n";
+            file << "64 80 3 3 1 mirror 0 direct\n";
+        }
+        bool exceptionThrown = false;
+        try
+        {
+            loaded.clear();
+            loaded.load("results/helpers/matrix/convolution_plans_invalid.txt");
+        }
+        catch (const std::runtime_error &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+        CHECK_EQUAL(0, loaded.size());
+    }
+
+    // With auto planning on, AUTO asks the global planner; off, the thresholds
+    TEST(ConvolutionPlannerTestSuite, AutoUsesGlobalPlanner)
+    {
+        using Convolution::Method;
+        Convolution::Planner &planner = Convolution::Planner::global();
+        planner.clear();
+        Matrix m = Matrix::random(40, 50, -1, 1);
+        Matrix kernel = Matrix::random(7, 7, -1, 1);
+        Matrix u = Matrix::random(5, 1, -1, 1), v = Matrix::random(1, 5, -1, 1);
+        FilterBank bank({u.matmul(v), v.transpose().matmul(u.transpose())});
+
+        CHECK(!Convolution::auto_planning());
+        m.cross_correlate(kernel);
+        bank.cross_correlate(m);
+        CHECK_EQUAL(0, planner.size());
+
+        Convolution::set_auto_planning(true);
+        Matrix direct = Convolution::cross_correlate(m, kernel, BorderMode::REFLECT_101, 0, Method::DIRECT);
+        CHECK(m.cross_correlate(kernel).is_close(direct, 1e-4));
+        CHECK(m.convolve(kernel.flip()).is_close(direct, 1e-4));
+        CHECK_EQUAL(1, planner.size());
+        std::vector<Matrix> outputs = bank.cross_correlate(m, BorderMode::REPLICATE);
+        CHECK(outputs[1].is_close(m.cross_correlate(bank.kernels[1], BorderMode::REPLICATE), 1e-4));
+        CHECK_EQUAL(3, planner.size());
+        CHECK(planner.find(Convolution::Planner::key(m, {bank.kernels[0], bank.kernels[1]}, BorderMode::REPLICATE)).has_value());
+        Convolution::set_auto_planning(false);
+        planner.clear();
+    }
+}
@@ -0,0 +1,114 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/FFT.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace VisualAlgo
+{
+    static std::vector<FFT::Complex> naive_dft(const std::vector<FFT::Complex> &x)
+    {
+        int n = x.size();
+        std::vector<FFT::Complex> result(n);
+        for (int k = 0; k < n; k++)
+            for (int j = 0; j < n; j++)
+                result[k] += x[j] * std::polar(1.0, -2 * M_PI * j * k / n);
+        return result;
+    }
+
+    static double max_difference(const std::vector<FFT::Complex> &a, const std::vector<FFT::Complex> &b)
+    {
+        double result = 0;
+        for (size_t i = 0; i < a.size(); i++)
+            result = std::max(result, std::abs(a[i] - b[i]));
+        return result;
+    }
+
+    TEST(FFTTestSuite, GoodSize)
+    {
+        CHECK_EQUAL(1, FFT::good_size(0));
+        CHECK_EQUAL(1, FFT::good_size(1));
+        CHECK_EQUAL(8, FFT::good_size(7));
+        CHECK_EQUAL(12, FFT::good_size(11));
+        CHECK_EQUAL(256, FFT::good_size(256));
+        CHECK_EQUAL(270, FFT::good_size(257));
+    }
+
+    // Every radix, a prime length and a mix of factors
+    TEST(FFTTestSuite, PlanMatchesNaiveDFT)
+    {
+        for (int n : {1, 2, 3, 7, 12, 16, 30, 49, 64, 100})
+        {
+            std::vector<FFT::Complex> x(n);
+            for (int j = 0; j < n; j++)
+                x[j] = FFT::Complex(std::rand() / (double)RAND_MAX - 0.5, std::rand() / (double)RAND_MAX - 0.5);
+
+            FFT::Plan plan(n);
+            CHECK_EQUAL(n, plan.size());
+            std::vector<FFT::Complex> spectrum = x;
+            plan.forward(spectrum.data());
+            CHECK(max_difference(spectrum, naive_dft(x)) < 1e-9 * n);
+
+            plan.inverse(spectrum.data());
+            CHECK(max_difference(spectrum, x) < 1e-12 * n);
+        }
+
+        bool exceptionThrown = false;
+        try
+        {
+            FFT::Plan plan(0);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    TEST(FFTTestSuite, RealPlan2D)
+    {
+        for (auto [rows, cols] : {std::pair{1, 1}, {5, 7}, {8, 6}, {9, 16}, {12, 15}})
+        {
+            FFT::RealPlan2D plan(rows, cols);
+            Matrix m = Matrix::random(rows, cols, -1, 1);
+            FFT::Spectrum spectrum = plan.forward(m);
+            CHECK_EQUAL(cols / 2 + 1, spectrum.spectrum_cols());
+
+            // Column 0 of the spectrum is the DFT of the row sums, its first entry the total
+            std::vector<FFT::Complex> row_sums(rows);
+            for (int i = 0; i < rows; i++)
+                for (int j = 0; j < cols; j++)
+                    row_sums[i] += m.get(i, j);
+            std::vector<FFT::Complex> expected = naive_dft(row_sums), column(rows);
+            for (int i = 0; i < rows; i++)
+                column[i] = spectrum[i][0];
+            CHECK(max_difference(column, expected) < 1e-9);
+
+            CHECK(plan.inverse(spectrum).is_close(m, 1e-6));
+        }
+
+        // A smaller input is zero-padded
+        FFT::RealPlan2D plan(6, 10);
+        Matrix small = Matrix::random(3, 4, -1, 1);
+        Matrix restored = plan.inverse(plan.forward(small));
+        CHECK_EQUAL(6, restored.rows);
+        CHECK_EQUAL(10, restored.cols);
+        CHECK(restored.submatrix(0, 3, 0, 4).is_close(small, 1e-6));
+        CHECK(restored.submatrix(3, 6, 0, 10).is_close(Matrix(3, 10, 0), 1e-6));
+
+        bool exceptionThrown = false;
+        try
+        {
+            plan.forward(Matrix(7, 10));
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+}
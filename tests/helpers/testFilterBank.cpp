@@ -0,0 +1,72 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/FilterBank.hpp"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace VisualAlgo
+{
+    // A bank gives exactly the outputs of its kernels applied one by one,
+    // whichever method runs it
+    TEST(FilterBankTestSuite, FilterBankMatchesSingleKernels)
+    {
+        Matrix m = Matrix::random(97, 120, -1, 1);
+        for (auto [kernel_size, method] : {std::pair{5, Convolution::Method::DIRECT}, {31, Convolution::Method::FFT}})
+        {
+            std::vector<Matrix> kernels;
+            for (int n = 0; n < 4; n++)
+                kernels.push_back(Matrix::random(kernel_size, kernel_size, -1, 1));
+            FilterBank bank(kernels, method);
+            CHECK_EQUAL(4, bank.size());
+
+            std::vector<Matrix> same_size = bank.cross_correlate(m, BorderMode::REFLECT);
+            std::vector<Matrix> padded = bank.cross_correlate(m, 3, 1, BorderMode::CONSTANT, 0.5f);
+            std::vector<Matrix> convolved = bank.convolve(m);
+            CHECK_EQUAL(4, (int)same_size.size());
+            for (int n = 0; n < 4; n++)
+            {
+                CHECK(same_size[n] == Convolution::cross_correlate(m, kernels[n], BorderMode::REFLECT, 0, method));
+                CHECK(padded[n] == Convolution::correlate_valid(MatrixView(m).pad(3, 3, 3, 3, BorderMode::CONSTANT, 0.5f), kernels[n], 1, method));
+                CHECK(convolved[n].is_close(m.convolve(kernels[n]), 1e-4));
+            }
+        }
+
+        // Strides go through the direct method
+        FilterBank bank({Matrix::random(3, 4, -1, 1), Matrix::random(3, 4, -1, 1)});
+        std::vector<Matrix> strided = bank.cross_correlate(m, 1, 2);
+        for (int n = 0; n < bank.size(); n++)
+            CHECK(strided[n] == m.cross_correlate(bank.kernels[n], 1, 2));
+    }
+
+    TEST(FilterBankTestSuite, FilterBankInvalidKernels)
+    {
+        Matrix m = Matrix::random(20, 20, -1, 1);
+        FilterBank bank;
+
+        bool exceptionThrown = false;
+        try
+        {
+            bank.cross_correlate(m);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+
+        bank.add(Matrix::random(3, 3, -1, 1));
+        exceptionThrown = false;
+        try
+        {
+            bank.add(Matrix::random(3, 5, -1, 1));
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+        CHECK_EQUAL(1, bank.size());
+    }
+}
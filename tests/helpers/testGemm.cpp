@@ -0,0 +1,96 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/Gemm.hpp"
+#include "helpers/Simd.hpp"
+#include "helpers/ThreadPool.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace VisualAlgo
+{
+    static Matrix naive_matmul(const Matrix &a, const Matrix &b)
+    {
+        Matrix result(a.rows, b.cols);
+        for (int i = 0; i < a.rows; i++)
+            for (int j = 0; j < b.cols; j++)
+            {
+                double sum = 0;
+                for (int k = 0; k < a.cols; k++)
+                    sum += static_cast<double>(a.get(i, k)) * b.get(k, j);
+                result.set(i, j, sum);
+            }
+        return result;
+    }
+
+    // Sizes are chosen to leave partial register tiles and, with k = 300,
+    // more than one cache block along the shared dimension.
+    TEST(GemmTestSuite, GemmMatchesNaiveProduct)
+    {
+        Matrix a = Matrix::random(37, 300, -1, 1);
+        Matrix b = Matrix::random(300, 45, -1, 1);
+        Matrix expected = naive_matmul(a, b);
+
+        for (Simd::Isa isa : {Simd::Isa::SCALAR, Simd::Isa::SSE4, Simd::Isa::AVX2, Simd::Isa::AVX512})
+        {
+            if (!Simd::is_supported(isa))
+                continue;
+            Simd::set_isa(isa);
+            CHECK(a.matmul(b).is_close(expected, 1e-3));
+        }
+        Simd::set_isa(Simd::best_isa());
+    }
+
+    TEST(GemmTestSuite, GemmThreadsGiveSameResult)
+    {
+        Matrix a = Matrix::random(101, 64, -1, 1);
+        Matrix b = Matrix::random(64, 33, -1, 1);
+        Matrix single(a.rows, b.cols), multi(a.rows, b.cols);
+        gemm(a.rows, b.cols, a.cols, a.data.data(), a.stride, b.data.data(), b.stride, single.data.data(), single.stride, false, 1);
+        gemm(a.rows, b.cols, a.cols, a.data.data(), a.stride, b.data.data(), b.stride, multi.data.data(), multi.stride, false, 4);
+        CHECK(single == multi);
+        CHECK(single.is_close(naive_matmul(a, b), 1e-3));
+    }
+
+    // Products split into panels from inside pool tasks share the same pool
+    TEST(GemmTestSuite, GemmNestedInPoolTasks)
+    {
+        Matrix a = Matrix::random(101, 64, -1, 1);
+        Matrix b = Matrix::random(64, 33, -1, 1);
+        Matrix expected(a.rows, b.cols);
+        gemm(a.rows, b.cols, a.cols, a.data.data(), a.stride, b.data.data(), b.stride, expected.data.data(), expected.stride, false, 1);
+
+        std::vector<Matrix> products(8, Matrix(a.rows, b.cols));
+        ThreadPool::global().parallel_for(products.size(), [&](int n)
+                                          { gemm(a.rows, b.cols, a.cols, a.data.data(), a.stride, b.data.data(), b.stride, products[n].data.data(), products[n].stride, false, 4); });
+        for (const Matrix &product : products)
+            CHECK(product == expected);
+    }
+
+    TEST(GemmTestSuite, GemmStridedAndAccumulate)
+    {
+        // Multiply the top-left 20x30 block of a by the top-left 30x25 block of b
+        // and add the result to the 20x25 block of c starting at (1, 2).
+        Matrix a = Matrix::random(24, 40, -1, 1);
+        Matrix b = Matrix::random(32, 28, -1, 1);
+        Matrix c(22, 30, 1);
+        gemm(20, 25, 30, a.data.data(), a.stride, b.data.data(), b.stride, &c[1][2], c.stride, true);
+
+        Matrix expected = naive_matmul(a.submatrix(0, 20, 0, 30), b.submatrix(0, 30, 0, 25)) + 1.0f;
+        CHECK(c.submatrix(1, 21, 2, 27).is_close(expected, 1e-3));
+        CHECK_EQUAL(1, c.get(0, 0));
+        CHECK_EQUAL(1, c.get(21, 29));
+        CHECK_EQUAL(1, c.get(1, 27));
+
+        bool exceptionThrown = false;
+        try
+        {
+            gemm(2, 2, 2, a.data.data(), 1, b.data.data(), b.stride, c.data.data(), c.stride);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+}
@@ -0,0 +1,125 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/Image.hpp"
+
+#include <stdexcept>
+
+namespace VisualAlgo
+{
+    TEST(ImageTestSuite, ImageLayouts)
+    {
+        Matrix r({{1, 2, 3}, {4, 5, 6}});
+        Matrix g({{10, 20, 30}, {40, 50, 60}});
+        Matrix b({{100, 110, 120}, {130, 140, 150}});
+
+        Image planar = Image::from_channels({r, g, b});
+        CHECK_EQUAL(3, planar.channels);
+        CHECK(planar.layout == ChannelLayout::PLANAR);
+        CHECK_EQUAL(2, planar.data[1]);
+        CHECK_EQUAL(10, planar.data[6]);
+        CHECK_EQUAL(50, planar.get(1, 1, 1));
+
+        Image interleaved = planar.to_layout(ChannelLayout::INTERLEAVED);
+        CHECK(interleaved.layout == ChannelLayout::INTERLEAVED);
+        CHECK_EQUAL(10, interleaved.data[1]);
+        CHECK_EQUAL(2, interleaved.data[3]);
+        CHECK_EQUAL(50, interleaved.get(1, 1, 1));
+        CHECK(interleaved.to_layout(ChannelLayout::PLANAR).data == planar.data);
+
+        bool exceptionThrown = false;
+        try
+        {
+            planar.get(0, 0, 3);
+        }
+        catch (const std::out_of_range &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    TEST(ImageTestSuite, ImageChannelViews)
+    {
+        Matrix r({{1, 2, 3}, {4, 5, 6}});
+        Matrix g({{10, 20, 30}, {40, 50, 60}});
+        Matrix b({{100, 110, 120}, {130, 140, 150}});
+
+        for (ChannelLayout layout : {ChannelLayout::PLANAR, ChannelLayout::INTERLEAVED})
+        {
+            Image image = Image::from_channels({r, g, b}, layout);
+            ChannelView green = image.channel(1);
+            CHECK_EQUAL(60, green.get(1, 2));
+            CHECK(green.to_matrix() == g);
+            CHECK(image.channel_matrix(2) == b);
+        }
+
+        // Planar channels are plain MatrixViews into the image buffer
+        Image planar = Image::from_channels({r, g, b});
+        MatrixView blue = planar.plane(2);
+        CHECK(blue.data == planar.data.data() + 12);
+        CHECK(blue.to_matrix() == b);
+
+        bool exceptionThrown = false;
+        try
+        {
+            planar.to_layout(ChannelLayout::INTERLEAVED).plane(0);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    TEST(ImageTestSuite, ImageColorConversions)
+    {
+        Matrix r = Matrix::random(5, 37, 0, 255);
+        Matrix g = Matrix::random(5, 37, 0, 255);
+        Matrix b = Matrix::random(5, 37, 0, 255);
+
+        for (ChannelLayout layout : {ChannelLayout::PLANAR, ChannelLayout::INTERLEAVED})
+        {
+            Image rgb = Image::from_channels({r, g, b}, layout);
+            Image ycbcr = rgb.rgb_to_ycbcr();
+            CHECK(ycbcr.layout == layout);
+            CHECK(ycbcr.channel_matrix(0).is_close(r * 0.2126f + g * 0.7152f + b * 0.0722f, 1e-3));
+            CHECK(rgb.to_gray().is_close(ycbcr.channel_matrix(0), 1e-3));
+
+            Image back = ycbcr.ycbcr_to_rgb();
+            for (int c = 0; c < 3; c++)
+                CHECK(back.channel_matrix(c).is_close(rgb.channel_matrix(c), 1e-2));
+        }
+
+        // Gray pixels have no chroma
+        Image gray(2, 2, 3, ChannelLayout::INTERLEAVED, 77);
+        Image ycbcr = gray.rgb_to_ycbcr();
+        CHECK_DOUBLES_EQUAL(77, ycbcr.get(1, 1, 0), 1e-3);
+        CHECK_DOUBLES_EQUAL(128, ycbcr.get(1, 1, 1), 1e-3);
+        CHECK_DOUBLES_EQUAL(128, ycbcr.get(1, 1, 2), 1e-3);
+    }
+
+    TEST(ImageTestSuite, ImageLoadSave)
+    {
+        Matrix gray;
+        gray.load("datasets/ImagePreprocessingAndEnhancement/lighthouse_dark.ppm");
+        Image image;
+        image.load("datasets/ImagePreprocessingAndEnhancement/lighthouse_dark.ppm", ChannelLayout::INTERLEAVED);
+        CHECK_EQUAL(3, image.channels);
+        CHECK_EQUAL(gray.rows, image.rows);
+        CHECK_EQUAL(gray.cols, image.cols);
+        CHECK(image.to_gray().is_close(gray, 1e-3));
+
+        image.save("results/helpers/matrix/image_rgb.ppm");
+        Image reloaded;
+        reloaded.load("results/helpers/matrix/image_rgb.ppm");
+        CHECK(reloaded.layout == ChannelLayout::PLANAR);
+        CHECK(reloaded.to_layout(ChannelLayout::INTERLEAVED).data == image.data);
+
+        // A single channel is saved as PGM
+        Image single(gray);
+        single.save("results/helpers/matrix/image_gray.pgm");
+        Image reloaded_gray;
+        reloaded_gray.load("results/helpers/matrix/image_gray.pgm");
+        CHECK_EQUAL(1, reloaded_gray.channels);
+    }
+}
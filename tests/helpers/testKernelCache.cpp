@@ -0,0 +1,111 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/KernelCache.hpp"
+#include "FeatureExtraction/Filter.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace VisualAlgo
+{
+    TEST(KernelCacheTestSuite, KernelCacheBuildsOnce)
+    {
+        KernelCache cache;
+        int builds = 0;
+        auto build = [&]()
+        {
+            builds++;
+            return Matrix::random(5, 5, -1, 1);
+        };
+
+        KernelCache::Kernel first = cache.get("random", {1, 2.5f}, build);
+        KernelCache::Kernel second = cache.get("random", {1, 2.5f}, build);
+        CHECK_EQUAL(1, builds);
+        CHECK(first == second);
+
+        // Another kind or other parameters are other kernels
+        CHECK(cache.get("other", {1, 2.5f}, build) != first);
+        CHECK(cache.get("random", {1, 2.25f}, build) != first);
+        CHECK(cache.get("random", {1}, build) != first);
+        CHECK_EQUAL(4, builds);
+        CHECK_EQUAL(4, cache.size());
+
+        // Kernels handed out survive a clear
+        Matrix copy = *first;
+        cache.clear();
+        CHECK_EQUAL(0, cache.size());
+        CHECK(*first == copy);
+        CHECK(cache.get("random", {1, 2.5f}, build) != first);
+    }
+
+    // Beyond its capacity the cache drops the least recently used kernels
+    TEST(KernelCacheTestSuite, KernelCacheEvictsLeastRecentlyUsed)
+    {
+        const size_t kernel_bytes = 10 * 10 * sizeof(float);
+        KernelCache cache(3 * kernel_bytes);
+        int builds = 0;
+        auto build = [&]()
+        {
+            builds++;
+            return Matrix(10, 10, 1);
+        };
+
+        KernelCache::Kernel first = cache.get("ones", {1}, build);
+        cache.get("ones", {2}, build);
+        cache.get("ones", {3}, build);
+        CHECK_EQUAL(3 * kernel_bytes, cache.bytes());
+        cache.get("ones", {1}, build); // now the most recently used
+        cache.get("ones", {4}, build); // drops {2}
+        CHECK_EQUAL(3, cache.size());
+        CHECK_EQUAL(3 * kernel_bytes, cache.bytes());
+        CHECK_EQUAL(4, builds);
+
+        CHECK(cache.get("ones", {1}, build) == first);
+        CHECK_EQUAL(4, builds);
+        cache.get("ones", {2}, build);
+        CHECK_EQUAL(5, builds);
+
+        // Too large to keep, but still built and handed out
+        KernelCache::Kernel large = cache.get("large", {1}, []()
+                                              { return Matrix(20, 20, 1); });
+        CHECK_EQUAL(20, large->rows);
+        CHECK_EQUAL(3, cache.size());
+        CHECK(cache.bytes() <= 3 * kernel_bytes);
+    }
+
+    TEST(KernelCacheTestSuite, KernelCacheSharedBetweenThreads)
+    {
+        KernelCache cache;
+        std::atomic<int> builds = 0;
+        std::vector<KernelCache::Kernel> kernels(8);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; t++)
+            threads.emplace_back([&, t]()
+                                 { kernels[t] = cache.get("ones", {3}, [&]()
+                                                          {
+                                                              builds++;
+                                                              return Matrix(3, 3, 1);
+                                                          }); });
+        for (std::thread &thread : threads)
+            thread.join();
+
+        // Threads may race to build, but all of them get the stored kernel
+        CHECK(builds >= 1);
+        CHECK_EQUAL(1, cache.size());
+        for (const KernelCache::Kernel &kernel : kernels)
+            CHECK(kernel == kernels[0]);
+    }
+
+    // Filters with the same sigma share their kernels through the global cache
+    TEST(KernelCacheTestSuite, FiltersUseGlobalCache)
+    {
+        int before = KernelCache::global().size();
+        FeatureExtraction::GaussianFilter first(2.375f), second(2.375f);
+        FeatureExtraction::LoGFilter log(2.375f);
+        CHECK_EQUAL(before + 2, KernelCache::global().size());
+
+        Matrix m = Matrix::random(40, 40, 0, 1);
+        CHECK(first.apply(m) == second.apply(m));
+    }
+}
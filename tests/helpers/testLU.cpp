@@ -0,0 +1,86 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/LU.hpp"
+
+#include <stdexcept>
+
+namespace VisualAlgo
+{
+    TEST(LUTestSuite, LUDet)
+    {
+        // Needs a row swap for the first pivot
+        Matrix m({{0, 2, 1}, {1, 1, 1}, {2, 1, 0}});
+        LU lu(m);
+        CHECK_EQUAL(3, lu.size());
+        CHECK(!lu.is_singular());
+        CHECK_DOUBLES_EQUAL(3, lu.det(), 1e-5);
+        CHECK_DOUBLES_EQUAL(3, m.det(), 1e-5);
+
+        // Triangular, the determinant is the product of the diagonal
+        Matrix t({{2, 5, 7, 1}, {0, 3, 1, 2}, {0, 0, -1, 4}, {0, 0, 0, 0.5}});
+        CHECK_DOUBLES_EQUAL(-3, LU(t).det(), 1e-5);
+
+        CHECK(LU(Matrix({{1, 2}, {2, 4}})).is_singular());
+        CHECK_EQUAL(0, LU(Matrix({{1, 2}, {2, 4}})).det());
+    }
+
+    TEST(LUTestSuite, LUSolveReusesFactorization)
+    {
+        // Diagonally dominant, hence well conditioned
+        const int n = 64;
+        Matrix a = Matrix::random(n, n, -1, 1) + Matrix::eye(n, n) * static_cast<float>(n);
+        LU lu(a);
+
+        for (int trial = 0; trial < 3; trial++)
+        {
+            Matrix b = Matrix::random(n, 1, -10, 10);
+            Matrix x = lu.solve(b);
+            CHECK_EQUAL(n, x.rows);
+            CHECK_EQUAL(1, x.cols);
+            CHECK(a.matmul(x).is_close(b, 1e-3));
+        }
+
+        // Several right-hand sides at once
+        Matrix b = Matrix::random(n, 5, -10, 10);
+        CHECK(a.matmul(lu.solve(b)).is_close(b, 1e-3));
+        CHECK(Matrix::solve(a, b).is_close(lu.solve(b), 1e-6));
+
+        CHECK(a.matmul(lu.inverse()).is_close(Matrix::eye(n, n), 1e-4));
+    }
+
+    TEST(LUTestSuite, LUErrors)
+    {
+        bool exceptionThrown = false;
+        try
+        {
+            LU lu(Matrix({{1, 2}, {3, 4}, {5, 6}}));
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK_EQUAL(true, exceptionThrown);
+
+        exceptionThrown = false;
+        try
+        {
+            LU(Matrix({{1, 2}, {3, 4}})).solve(Matrix(3, 1));
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK_EQUAL(true, exceptionThrown);
+
+        exceptionThrown = false;
+        try
+        {
+            Matrix::solve(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}), Matrix(3, 1, 1));
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK_EQUAL(true, exceptionThrown);
+    }
+}
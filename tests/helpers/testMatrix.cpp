@@ -2,6 +2,7 @@
 #include "helpers/Matrix.hpp"
 
 #include <vector>
+#include <type_traits>
 
 namespace VisualAlgo
 {
@@ -10,12 +11,12 @@ namespace VisualAlgo
         Matrix m(2, 3);
         CHECK_EQUAL(2, m.rows);
         CHECK_EQUAL(3, m.cols);
-        CHECK_EQUAL(0, m.data[0][0]);
-        CHECK_EQUAL(0, m.data[0][1]);
-        CHECK_EQUAL(0, m.data[0][2]);
-        CHECK_EQUAL(0, m.data[1][0]);
-        CHECK_EQUAL(0, m.data[1][1]);
-        CHECK_EQUAL(0, m.data[1][2]);
+        CHECK_EQUAL(0, m[0][0]);
+        CHECK_EQUAL(0, m[0][1]);
+        CHECK_EQUAL(0, m[0][2]);
+        CHECK_EQUAL(0, m[1][0]);
+        CHECK_EQUAL(0, m[1][1]);
+        CHECK_EQUAL(0, m[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -34,12 +35,12 @@ namespace VisualAlgo
         Matrix m(2, 3, 1);
         CHECK_EQUAL(2, m.rows);
         CHECK_EQUAL(3, m.cols);
-        CHECK_EQUAL(1, m.data[0][0]);
-        CHECK_EQUAL(1, m.data[0][1]);
-        CHECK_EQUAL(1, m.data[0][2]);
-        CHECK_EQUAL(1, m.data[1][0]);
-        CHECK_EQUAL(1, m.data[1][1]);
-        CHECK_EQUAL(1, m.data[1][2]);
+        CHECK_EQUAL(1, m[0][0]);
+        CHECK_EQUAL(1, m[0][1]);
+        CHECK_EQUAL(1, m[0][2]);
+        CHECK_EQUAL(1, m[1][0]);
+        CHECK_EQUAL(1, m[1][1]);
+        CHECK_EQUAL(1, m[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -59,12 +60,12 @@ namespace VisualAlgo
         Matrix m(data);
         CHECK_EQUAL(2, m.rows);
         CHECK_EQUAL(3, m.cols);
-        CHECK_EQUAL(1, m.data[0][0]);
-        CHECK_EQUAL(2, m.data[0][1]);
-        CHECK_EQUAL(3, m.data[0][2]);
-        CHECK_EQUAL(4, m.data[1][0]);
-        CHECK_EQUAL(5, m.data[1][1]);
-        CHECK_EQUAL(6, m.data[1][2]);
+        CHECK_EQUAL(1, m[0][0]);
+        CHECK_EQUAL(2, m[0][1]);
+        CHECK_EQUAL(3, m[0][2]);
+        CHECK_EQUAL(4, m[1][0]);
+        CHECK_EQUAL(5, m[1][1]);
+        CHECK_EQUAL(6, m[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixCopyConstructor)
@@ -74,17 +75,17 @@ namespace VisualAlgo
         Matrix m2(m1);
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(1, m2.data[0][0]);
-        CHECK_EQUAL(2, m2.data[0][1]);
-        CHECK_EQUAL(3, m2.data[0][2]);
-        CHECK_EQUAL(4, m2.data[1][0]);
-        CHECK_EQUAL(5, m2.data[1][1]);
-        CHECK_EQUAL(6, m2.data[1][2]);
+        CHECK_EQUAL(1, m2[0][0]);
+        CHECK_EQUAL(2, m2[0][1]);
+        CHECK_EQUAL(3, m2[0][2]);
+        CHECK_EQUAL(4, m2[1][0]);
+        CHECK_EQUAL(5, m2[1][1]);
+        CHECK_EQUAL(6, m2[1][2]);
 
         // Check if m1 and m2 are independent
         m1.set(0, 0, 0);
-        CHECK_EQUAL(0, m1.data[0][0]);
-        CHECK_EQUAL(1, m2.data[0][0]);
+        CHECK_EQUAL(0, m1[0][0]);
+        CHECK_EQUAL(1, m2[0][0]);
     }
 
     TEST(MatrixTestSuite, MatrixAssignmentOperator)
@@ -94,17 +95,58 @@ namespace VisualAlgo
         Matrix m2 = m1;
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(1, m2.data[0][0]);
-        CHECK_EQUAL(2, m2.data[0][1]);
-        CHECK_EQUAL(3, m2.data[0][2]);
-        CHECK_EQUAL(4, m2.data[1][0]);
-        CHECK_EQUAL(5, m2.data[1][1]);
-        CHECK_EQUAL(6, m2.data[1][2]);
+        CHECK_EQUAL(1, m2[0][0]);
+        CHECK_EQUAL(2, m2[0][1]);
+        CHECK_EQUAL(3, m2[0][2]);
+        CHECK_EQUAL(4, m2[1][0]);
+        CHECK_EQUAL(5, m2[1][1]);
+        CHECK_EQUAL(6, m2[1][2]);
 
         // Check if m1 and m2 are independent
         m1.set(0, 0, 0);
-        CHECK_EQUAL(0, m1.data[0][0]);
-        CHECK_EQUAL(1, m2.data[0][0]);
+        CHECK_EQUAL(0, m1[0][0]);
+        CHECK_EQUAL(1, m2[0][0]);
+    }
+
+    TEST(MatrixTestSuite, MatrixMoveConstructorAndAssignment)
+    {
+        Matrix m1({{1, 2, 3}, {4, 5, 6}});
+        const float *buffer = m1.data.data();
+
+        Matrix m2(std::move(m1));
+        CHECK(m2.data.data() == buffer);
+        CHECK(m2 == Matrix({{1, 2, 3}, {4, 5, 6}}));
+        CHECK_EQUAL(0, m1.rows);
+        CHECK_EQUAL(0, m1.cols);
+
+        Matrix m3(1, 1);
+        m3 = std::move(m2);
+        CHECK(m3.data.data() == buffer);
+        CHECK_EQUAL(2, m3.rows);
+        CHECK_EQUAL(3, m3.cols);
+        CHECK_EQUAL(0, m2.rows);
+    }
+
+    TEST(MatrixTestSuite, MatrixExpiringOperandReuse)
+    {
+        Matrix a({{1, 2, 3}, {4, 5, 6}});
+        Matrix b(2, 3, 1);
+
+        // The result takes over the buffer of an expiring operand instead of allocating.
+        const float *buffer = a.data.data();
+        Matrix c = (std::move(a) + b) * 2;
+        CHECK(c.data.data() == buffer);
+        CHECK(c == Matrix({{4, 6, 8}, {10, 12, 14}}));
+
+        buffer = c.data.data();
+        Matrix d = b - std::move(c);
+        CHECK(d.data.data() == buffer);
+        CHECK(d == Matrix({{-3, -5, -7}, {-9, -11, -13}}));
+
+        // Lvalue operands are never modified.
+        Matrix e = b + b;
+        CHECK(b == Matrix(2, 3, 1));
+        CHECK(e == Matrix(2, 3, 2));
     }
 
     TEST(MatrixTestSuite, MatrixSetAndGet)
@@ -131,12 +173,12 @@ namespace VisualAlgo
         Matrix m3 = m1 + m2;
         CHECK_EQUAL(2, m3.rows);
         CHECK_EQUAL(3, m3.cols);
-        CHECK_EQUAL(3, m3.data[0][0]);
-        CHECK_EQUAL(3, m3.data[0][1]);
-        CHECK_EQUAL(3, m3.data[0][2]);
-        CHECK_EQUAL(3, m3.data[1][0]);
-        CHECK_EQUAL(3, m3.data[1][1]);
-        CHECK_EQUAL(3, m3.data[1][2]);
+        CHECK_EQUAL(3, m3[0][0]);
+        CHECK_EQUAL(3, m3[0][1]);
+        CHECK_EQUAL(3, m3[0][2]);
+        CHECK_EQUAL(3, m3[1][0]);
+        CHECK_EQUAL(3, m3[1][1]);
+        CHECK_EQUAL(3, m3[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -159,12 +201,12 @@ namespace VisualAlgo
         Matrix m3 = m1 - m2;
         CHECK_EQUAL(2, m3.rows);
         CHECK_EQUAL(3, m3.cols);
-        CHECK_EQUAL(-1, m3.data[0][0]);
-        CHECK_EQUAL(-1, m3.data[0][1]);
-        CHECK_EQUAL(-1, m3.data[0][2]);
-        CHECK_EQUAL(-1, m3.data[1][0]);
-        CHECK_EQUAL(-1, m3.data[1][1]);
-        CHECK_EQUAL(-1, m3.data[1][2]);
+        CHECK_EQUAL(-1, m3[0][0]);
+        CHECK_EQUAL(-1, m3[0][1]);
+        CHECK_EQUAL(-1, m3[0][2]);
+        CHECK_EQUAL(-1, m3[1][0]);
+        CHECK_EQUAL(-1, m3[1][1]);
+        CHECK_EQUAL(-1, m3[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -187,12 +229,12 @@ namespace VisualAlgo
         Matrix m3 = m1 * m2;
         CHECK_EQUAL(2, m3.rows);
         CHECK_EQUAL(3, m3.cols);
-        CHECK_EQUAL(2, m3.data[0][0]);
-        CHECK_EQUAL(2, m3.data[0][1]);
-        CHECK_EQUAL(2, m3.data[0][2]);
-        CHECK_EQUAL(2, m3.data[1][0]);
-        CHECK_EQUAL(2, m3.data[1][1]);
-        CHECK_EQUAL(2, m3.data[1][2]);
+        CHECK_EQUAL(2, m3[0][0]);
+        CHECK_EQUAL(2, m3[0][1]);
+        CHECK_EQUAL(2, m3[0][2]);
+        CHECK_EQUAL(2, m3[1][0]);
+        CHECK_EQUAL(2, m3[1][1]);
+        CHECK_EQUAL(2, m3[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -215,12 +257,12 @@ namespace VisualAlgo
         Matrix m3 = m1 / m2;
         CHECK_EQUAL(2, m3.rows);
         CHECK_EQUAL(3, m3.cols);
-        CHECK_EQUAL(0.5, m3.data[0][0]);
-        CHECK_EQUAL(0.5, m3.data[0][1]);
-        CHECK_EQUAL(0.5, m3.data[0][2]);
-        CHECK_EQUAL(0.5, m3.data[1][0]);
-        CHECK_EQUAL(0.5, m3.data[1][1]);
-        CHECK_EQUAL(0.5, m3.data[1][2]);
+        CHECK_EQUAL(0.5, m3[0][0]);
+        CHECK_EQUAL(0.5, m3[0][1]);
+        CHECK_EQUAL(0.5, m3[0][2]);
+        CHECK_EQUAL(0.5, m3[1][0]);
+        CHECK_EQUAL(0.5, m3[1][1]);
+        CHECK_EQUAL(0.5, m3[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -243,12 +285,12 @@ namespace VisualAlgo
         m1 += m2;
         CHECK_EQUAL(2, m1.rows);
         CHECK_EQUAL(3, m1.cols);
-        CHECK_EQUAL(3, m1.data[0][0]);
-        CHECK_EQUAL(3, m1.data[0][1]);
-        CHECK_EQUAL(3, m1.data[0][2]);
-        CHECK_EQUAL(3, m1.data[1][0]);
-        CHECK_EQUAL(3, m1.data[1][1]);
-        CHECK_EQUAL(3, m1.data[1][2]);
+        CHECK_EQUAL(3, m1[0][0]);
+        CHECK_EQUAL(3, m1[0][1]);
+        CHECK_EQUAL(3, m1[0][2]);
+        CHECK_EQUAL(3, m1[1][0]);
+        CHECK_EQUAL(3, m1[1][1]);
+        CHECK_EQUAL(3, m1[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -271,12 +313,12 @@ namespace VisualAlgo
         m1 -= m2;
         CHECK_EQUAL(2, m1.rows);
         CHECK_EQUAL(3, m1.cols);
-        CHECK_EQUAL(-1, m1.data[0][0]);
-        CHECK_EQUAL(-1, m1.data[0][1]);
-        CHECK_EQUAL(-1, m1.data[0][2]);
-        CHECK_EQUAL(-1, m1.data[1][0]);
-        CHECK_EQUAL(-1, m1.data[1][1]);
-        CHECK_EQUAL(-1, m1.data[1][2]);
+        CHECK_EQUAL(-1, m1[0][0]);
+        CHECK_EQUAL(-1, m1[0][1]);
+        CHECK_EQUAL(-1, m1[0][2]);
+        CHECK_EQUAL(-1, m1[1][0]);
+        CHECK_EQUAL(-1, m1[1][1]);
+        CHECK_EQUAL(-1, m1[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorMultiplyEqual)
@@ -286,12 +328,12 @@ namespace VisualAlgo
         m1 *= m2;
         CHECK_EQUAL(2, m1.rows);
         CHECK_EQUAL(3, m1.cols);
-        CHECK_EQUAL(2, m1.data[0][0]);
-        CHECK_EQUAL(2, m1.data[0][1]);
-        CHECK_EQUAL(2, m1.data[0][2]);
-        CHECK_EQUAL(2, m1.data[1][0]);
-        CHECK_EQUAL(2, m1.data[1][1]);
-        CHECK_EQUAL(2, m1.data[1][2]);
+        CHECK_EQUAL(2, m1[0][0]);
+        CHECK_EQUAL(2, m1[0][1]);
+        CHECK_EQUAL(2, m1[0][2]);
+        CHECK_EQUAL(2, m1[1][0]);
+        CHECK_EQUAL(2, m1[1][1]);
+        CHECK_EQUAL(2, m1[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorDivideEqual)
@@ -301,12 +343,12 @@ namespace VisualAlgo
         m1 /= m2;
         CHECK_EQUAL(2, m1.rows);
         CHECK_EQUAL(3, m1.cols);
-        CHECK_EQUAL(0.5, m1.data[0][0]);
-        CHECK_EQUAL(0.5, m1.data[0][1]);
-        CHECK_EQUAL(0.5, m1.data[0][2]);
-        CHECK_EQUAL(0.5, m1.data[1][0]);
-        CHECK_EQUAL(0.5, m1.data[1][1]);
-        CHECK_EQUAL(0.5, m1.data[1][2]);
+        CHECK_EQUAL(0.5, m1[0][0]);
+        CHECK_EQUAL(0.5, m1[0][1]);
+        CHECK_EQUAL(0.5, m1[0][2]);
+        CHECK_EQUAL(0.5, m1[1][0]);
+        CHECK_EQUAL(0.5, m1[1][1]);
+        CHECK_EQUAL(0.5, m1[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorPlusScalar)
@@ -315,12 +357,12 @@ namespace VisualAlgo
         Matrix m2 = m1 + 2;
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(3, m2.data[0][0]);
-        CHECK_EQUAL(3, m2.data[0][1]);
-        CHECK_EQUAL(3, m2.data[0][2]);
-        CHECK_EQUAL(3, m2.data[1][0]);
-        CHECK_EQUAL(3, m2.data[1][1]);
-        CHECK_EQUAL(3, m2.data[1][2]);
+        CHECK_EQUAL(3, m2[0][0]);
+        CHECK_EQUAL(3, m2[0][1]);
+        CHECK_EQUAL(3, m2[0][2]);
+        CHECK_EQUAL(3, m2[1][0]);
+        CHECK_EQUAL(3, m2[1][1]);
+        CHECK_EQUAL(3, m2[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorMinusScalar)
@@ -329,12 +371,12 @@ namespace VisualAlgo
         Matrix m2 = m1 - 2;
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(-1, m2.data[0][0]);
-        CHECK_EQUAL(-1, m2.data[0][1]);
-        CHECK_EQUAL(-1, m2.data[0][2]);
-        CHECK_EQUAL(-1, m2.data[1][0]);
-        CHECK_EQUAL(-1, m2.data[1][1]);
-        CHECK_EQUAL(-1, m2.data[1][2]);
+        CHECK_EQUAL(-1, m2[0][0]);
+        CHECK_EQUAL(-1, m2[0][1]);
+        CHECK_EQUAL(-1, m2[0][2]);
+        CHECK_EQUAL(-1, m2[1][0]);
+        CHECK_EQUAL(-1, m2[1][1]);
+        CHECK_EQUAL(-1, m2[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorMultiplyScalar)
@@ -343,12 +385,12 @@ namespace VisualAlgo
         Matrix m2 = m1 * 2;
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(2, m2.data[0][0]);
-        CHECK_EQUAL(2, m2.data[0][1]);
-        CHECK_EQUAL(2, m2.data[0][2]);
-        CHECK_EQUAL(2, m2.data[1][0]);
-        CHECK_EQUAL(2, m2.data[1][1]);
-        CHECK_EQUAL(2, m2.data[1][2]);
+        CHECK_EQUAL(2, m2[0][0]);
+        CHECK_EQUAL(2, m2[0][1]);
+        CHECK_EQUAL(2, m2[0][2]);
+        CHECK_EQUAL(2, m2[1][0]);
+        CHECK_EQUAL(2, m2[1][1]);
+        CHECK_EQUAL(2, m2[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorDivideScalar)
@@ -357,12 +399,12 @@ namespace VisualAlgo
         Matrix m2 = m1 / 2;
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(0.5, m2.data[0][0]);
-        CHECK_EQUAL(0.5, m2.data[0][1]);
-        CHECK_EQUAL(0.5, m2.data[0][2]);
-        CHECK_EQUAL(0.5, m2.data[1][0]);
-        CHECK_EQUAL(0.5, m2.data[1][1]);
-        CHECK_EQUAL(0.5, m2.data[1][2]);
+        CHECK_EQUAL(0.5, m2[0][0]);
+        CHECK_EQUAL(0.5, m2[0][1]);
+        CHECK_EQUAL(0.5, m2[0][2]);
+        CHECK_EQUAL(0.5, m2[1][0]);
+        CHECK_EQUAL(0.5, m2[1][1]);
+        CHECK_EQUAL(0.5, m2[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorUnaryMinus)
@@ -371,12 +413,47 @@ namespace VisualAlgo
         Matrix m2 = -m1;
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(-1, m2.data[0][0]);
-        CHECK_EQUAL(-1, m2.data[0][1]);
-        CHECK_EQUAL(-1, m2.data[0][2]);
-        CHECK_EQUAL(-1, m2.data[1][0]);
-        CHECK_EQUAL(-1, m2.data[1][1]);
-        CHECK_EQUAL(-1, m2.data[1][2]);
+        CHECK_EQUAL(-1, m2[0][0]);
+        CHECK_EQUAL(-1, m2[0][1]);
+        CHECK_EQUAL(-1, m2[0][2]);
+        CHECK_EQUAL(-1, m2[1][0]);
+        CHECK_EQUAL(-1, m2[1][1]);
+        CHECK_EQUAL(-1, m2[1][2]);
+    }
+
+    TEST(MatrixTestSuite, MatrixExpressionFused)
+    {
+        Matrix a({{1, 2, 3}, {4, 5, 6}});
+        Matrix b({{6, 5, 4}, {3, 2, 1}});
+
+        // Operators build lazy expressions instead of temporary matrices.
+        CHECK(!(std::is_same_v<decltype(a + b), Matrix>));
+
+        Matrix c = (a - b) * (2.0f * 2.0f) + a / b - 1;
+        for (int i = 0; i < 2; i++)
+            for (int j = 0; j < 3; j++)
+                CHECK_DOUBLES_EQUAL((a.get(i, j) - b.get(i, j)) * 4 + a.get(i, j) / b.get(i, j) - 1, c.get(i, j), 1e-5);
+
+        Matrix d = 12.0f / a - -b;
+        CHECK(d.is_close(Matrix({{18, 11, 8}, {6, 4.4, 3}})));
+
+        // Assigning an expression that reads the target is evaluated in place.
+        a = a * 2 + a;
+        CHECK(a == Matrix({{3, 6, 9}, {12, 15, 18}}));
+
+        a -= b * 2 + 1;
+        CHECK(a == Matrix({{-10, -5, 0}, {5, 10, 15}}));
+
+        bool exceptionThrown = false;
+        try
+        {
+            Matrix e = (a + b) * Matrix(3, 2);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorPower)
@@ -385,12 +462,12 @@ namespace VisualAlgo
         Matrix m2 = m1 ^ 2;
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(4, m2.data[0][0]);
-        CHECK_EQUAL(4, m2.data[0][1]);
-        CHECK_EQUAL(4, m2.data[0][2]);
-        CHECK_EQUAL(4, m2.data[1][0]);
-        CHECK_EQUAL(4, m2.data[1][1]);
-        CHECK_EQUAL(4, m2.data[1][2]);
+        CHECK_EQUAL(4, m2[0][0]);
+        CHECK_EQUAL(4, m2[0][1]);
+        CHECK_EQUAL(4, m2[0][2]);
+        CHECK_EQUAL(4, m2[1][0]);
+        CHECK_EQUAL(4, m2[1][1]);
+        CHECK_EQUAL(4, m2[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOperatorSubscript)
@@ -402,12 +479,22 @@ namespace VisualAlgo
         m[1][0] = 5;
         m[1][1] = 6;
         m[1][2] = 7;
-        CHECK_EQUAL(2, m.data[0][0]);
-        CHECK_EQUAL(3, m.data[0][1]);
-        CHECK_EQUAL(4, m.data[0][2]);
-        CHECK_EQUAL(5, m.data[1][0]);
-        CHECK_EQUAL(6, m.data[1][1]);
-        CHECK_EQUAL(7, m.data[1][2]);
+        CHECK_EQUAL(2, m[0][0]);
+        CHECK_EQUAL(3, m[0][1]);
+        CHECK_EQUAL(4, m[0][2]);
+        CHECK_EQUAL(5, m[1][0]);
+        CHECK_EQUAL(6, m[1][1]);
+        CHECK_EQUAL(7, m[1][2]);
+    }
+
+    TEST(MatrixTestSuite, MatrixContiguousStorage)
+    {
+        Matrix m = {{1, 2, 3}, {4, 5, 6}};
+        CHECK_EQUAL(3, m.stride);
+        CHECK_EQUAL(6, static_cast<int>(m.data.size()));
+        CHECK(m[1] == m[0] + m.stride);
+        for (int i = 0; i < 6; i++)
+            CHECK_EQUAL(i + 1, m.data[i]);
     }
 
     // Comparison
@@ -466,12 +553,12 @@ namespace VisualAlgo
         Matrix mT = m.transpose();
         CHECK_EQUAL(3, mT.rows);
         CHECK_EQUAL(2, mT.cols);
-        CHECK_EQUAL(1, mT.data[0][0]);
-        CHECK_EQUAL(1, mT.data[0][1]);
-        CHECK_EQUAL(1, mT.data[1][0]);
-        CHECK_EQUAL(1, mT.data[1][1]);
-        CHECK_EQUAL(1, mT.data[2][0]);
-        CHECK_EQUAL(1, mT.data[2][1]);
+        CHECK_EQUAL(1, mT[0][0]);
+        CHECK_EQUAL(1, mT[0][1]);
+        CHECK_EQUAL(1, mT[1][0]);
+        CHECK_EQUAL(1, mT[1][1]);
+        CHECK_EQUAL(1, mT[2][0]);
+        CHECK_EQUAL(1, mT[2][1]);
     }
 
     TEST(MatrixTestSuite, MatrixDot)
@@ -488,26 +575,26 @@ namespace VisualAlgo
         Matrix m2 = m1.submatrix(0, 1, 0, 1);
         CHECK_EQUAL(1, m2.rows);
         CHECK_EQUAL(1, m2.cols);
-        CHECK_EQUAL(1, m2.data[0][0]);
+        CHECK_EQUAL(1, m2[0][0]);
 
         m2 = m1.submatrix(0, 1, 1, 2);
         CHECK_EQUAL(1, m2.rows);
         CHECK_EQUAL(1, m2.cols);
-        CHECK_EQUAL(2, m2.data[0][0]);
+        CHECK_EQUAL(2, m2[0][0]);
 
         m2 = m1.submatrix(0, 2, 0, 2);
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(2, m2.cols);
-        CHECK_EQUAL(1, m2.data[0][0]);
-        CHECK_EQUAL(2, m2.data[0][1]);
-        CHECK_EQUAL(4, m2.data[1][0]);
-        CHECK_EQUAL(5, m2.data[1][1]);
+        CHECK_EQUAL(1, m2[0][0]);
+        CHECK_EQUAL(2, m2[0][1]);
+        CHECK_EQUAL(4, m2[1][0]);
+        CHECK_EQUAL(5, m2[1][1]);
 
         m2 = m1.submatrix(0, 2, 1, 2);
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(1, m2.cols);
-        CHECK_EQUAL(2, m2.data[0][0]);
-        CHECK_EQUAL(5, m2.data[1][0]);
+        CHECK_EQUAL(2, m2[0][0]);
+        CHECK_EQUAL(5, m2[1][0]);
 
         bool exceptionThrown = false;
         try
@@ -664,10 +751,10 @@ namespace VisualAlgo
         auto m3 = m1.matmul(m2);
         CHECK_EQUAL(2, m3.rows);
         CHECK_EQUAL(2, m3.cols);
-        CHECK_EQUAL(140, m3.data[0][0]);
-        CHECK_EQUAL(146, m3.data[0][1]);
-        CHECK_EQUAL(320, m3.data[1][0]);
-        CHECK_EQUAL(335, m3.data[1][1]);
+        CHECK_EQUAL(140, m3[0][0]);
+        CHECK_EQUAL(146, m3[0][1]);
+        CHECK_EQUAL(320, m3[1][0]);
+        CHECK_EQUAL(335, m3[1][1]);
 
         bool exceptionThrown = false;
         try
@@ -761,12 +848,12 @@ namespace VisualAlgo
         m2.load("results/helpers/matrix/test.ppm");
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(1, m2.data[0][0]);
-        CHECK_EQUAL(1, m2.data[0][1]);
-        CHECK_EQUAL(1, m2.data[0][2]);
-        CHECK_EQUAL(1, m2.data[1][0]);
-        CHECK_EQUAL(1, m2.data[1][1]);
-        CHECK_EQUAL(1, m2.data[1][2]);
+        CHECK_EQUAL(1, m2[0][0]);
+        CHECK_EQUAL(1, m2[0][1]);
+        CHECK_EQUAL(1, m2[0][2]);
+        CHECK_EQUAL(1, m2[1][0]);
+        CHECK_EQUAL(1, m2[1][1]);
+        CHECK_EQUAL(1, m2[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -789,12 +876,12 @@ namespace VisualAlgo
         m2.load("results/helpers/matrix/test.ppm");
         CHECK_EQUAL(2, m2.rows);
         CHECK_EQUAL(3, m2.cols);
-        CHECK_EQUAL(0, m2.data[0][0]);
-        CHECK_EQUAL(0, m2.data[0][1]);
-        CHECK_EQUAL(0, m2.data[0][2]);
-        CHECK_EQUAL(0, m2.data[1][0]);
-        CHECK_EQUAL(127, m2.data[1][1]);
-        CHECK_EQUAL(255, m2.data[1][2]);
+        CHECK_EQUAL(0, m2[0][0]);
+        CHECK_EQUAL(0, m2[0][1]);
+        CHECK_EQUAL(0, m2[0][2]);
+        CHECK_EQUAL(0, m2[1][0]);
+        CHECK_EQUAL(127, m2[1][1]);
+        CHECK_EQUAL(255, m2[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -853,12 +940,12 @@ namespace VisualAlgo
         m1.relu();
         CHECK_EQUAL(2, m1.rows);
         CHECK_EQUAL(3, m1.cols);
-        CHECK_EQUAL(0, m1.data[0][0]);
-        CHECK_EQUAL(0, m1.data[0][1]);
-        CHECK_EQUAL(0, m1.data[0][2]);
-        CHECK_EQUAL(0, m1.data[1][0]);
-        CHECK_EQUAL(55, m1.data[1][1]);
-        CHECK_EQUAL(0, m1.data[1][2]);
+        CHECK_EQUAL(0, m1[0][0]);
+        CHECK_EQUAL(0, m1[0][1]);
+        CHECK_EQUAL(0, m1[0][2]);
+        CHECK_EQUAL(0, m1[1][0]);
+        CHECK_EQUAL(55, m1[1][1]);
+        CHECK_EQUAL(0, m1[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixCrossCorrelation)
@@ -871,8 +958,8 @@ namespace VisualAlgo
         Matrix m3 = m1.cross_correlate(m2, 0, 1);
         CHECK_EQUAL(1, m3.rows);
         CHECK_EQUAL(2, m3.cols);
-        CHECK_EQUAL(37, m3.data[0][0]);
-        CHECK_EQUAL(47, m3.data[0][1]);
+        CHECK_EQUAL(37, m3[0][0]);
+        CHECK_EQUAL(47, m3[0][1]);
 
         // Test 2
         Matrix m4({{1, 2, 3}, {4, 5, 6}});
@@ -880,18 +967,18 @@ namespace VisualAlgo
         Matrix m6 = m4.cross_correlate(m5, 1, 1);
         CHECK_EQUAL(3, m6.rows);
         CHECK_EQUAL(4, m6.cols);
-        CHECK_EQUAL(4, m6.data[0][0]);
-        CHECK_EQUAL(11, m6.data[0][1]);
-        CHECK_EQUAL(18, m6.data[0][2]);
-        CHECK_EQUAL(9, m6.data[0][3]);
-        CHECK_EQUAL(18, m6.data[1][0]);
-        CHECK_EQUAL(37, m6.data[1][1]);
-        CHECK_EQUAL(47, m6.data[1][2]);
-        CHECK_EQUAL(21, m6.data[1][3]);
-        CHECK_EQUAL(8, m6.data[2][0]);
-        CHECK_EQUAL(14, m6.data[2][1]);
-        CHECK_EQUAL(17, m6.data[2][2]);
-        CHECK_EQUAL(6, m6.data[2][3]);
+        CHECK_EQUAL(4, m6[0][0]);
+        CHECK_EQUAL(11, m6[0][1]);
+        CHECK_EQUAL(18, m6[0][2]);
+        CHECK_EQUAL(9, m6[0][3]);
+        CHECK_EQUAL(18, m6[1][0]);
+        CHECK_EQUAL(37, m6[1][1]);
+        CHECK_EQUAL(47, m6[1][2]);
+        CHECK_EQUAL(21, m6[1][3]);
+        CHECK_EQUAL(8, m6[2][0]);
+        CHECK_EQUAL(14, m6[2][1]);
+        CHECK_EQUAL(17, m6[2][2]);
+        CHECK_EQUAL(6, m6[2][3]);
 
         // Test 3
         Matrix m7({{1, 2, 3}, {4, 5, 6}});
@@ -899,10 +986,10 @@ namespace VisualAlgo
         Matrix m9 = m7.cross_correlate(m8, 1, 2);
         CHECK_EQUAL(2, m9.rows);
         CHECK_EQUAL(2, m9.cols);
-        CHECK_EQUAL(4, m9.data[0][0]);
-        CHECK_EQUAL(18, m9.data[0][1]);
-        CHECK_EQUAL(8, m9.data[1][0]);
-        CHECK_EQUAL(17, m9.data[1][1]);
+        CHECK_EQUAL(4, m9[0][0]);
+        CHECK_EQUAL(18, m9[0][1]);
+        CHECK_EQUAL(8, m9[1][0]);
+        CHECK_EQUAL(17, m9[1][1]);
 
         // Test exceptions: kernel size > matrix size
         bool exceptionThrown = false;
@@ -952,12 +1039,12 @@ namespace VisualAlgo
         Matrix m = Matrix::zeros(2, 3);
         CHECK_EQUAL(2, m.rows);
         CHECK_EQUAL(3, m.cols);
-        CHECK_EQUAL(0, m.data[0][0]);
-        CHECK_EQUAL(0, m.data[0][1]);
-        CHECK_EQUAL(0, m.data[0][2]);
-        CHECK_EQUAL(0, m.data[1][0]);
-        CHECK_EQUAL(0, m.data[1][1]);
-        CHECK_EQUAL(0, m.data[1][2]);
+        CHECK_EQUAL(0, m[0][0]);
+        CHECK_EQUAL(0, m[0][1]);
+        CHECK_EQUAL(0, m[0][2]);
+        CHECK_EQUAL(0, m[1][0]);
+        CHECK_EQUAL(0, m[1][1]);
+        CHECK_EQUAL(0, m[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixOnes)
@@ -965,12 +1052,12 @@ namespace VisualAlgo
         Matrix m = Matrix::ones(2, 3);
         CHECK_EQUAL(2, m.rows);
         CHECK_EQUAL(3, m.cols);
-        CHECK_EQUAL(1, m.data[0][0]);
-        CHECK_EQUAL(1, m.data[0][1]);
-        CHECK_EQUAL(1, m.data[0][2]);
-        CHECK_EQUAL(1, m.data[1][0]);
-        CHECK_EQUAL(1, m.data[1][1]);
-        CHECK_EQUAL(1, m.data[1][2]);
+        CHECK_EQUAL(1, m[0][0]);
+        CHECK_EQUAL(1, m[0][1]);
+        CHECK_EQUAL(1, m[0][2]);
+        CHECK_EQUAL(1, m[1][0]);
+        CHECK_EQUAL(1, m[1][1]);
+        CHECK_EQUAL(1, m[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixEye)
@@ -978,12 +1065,12 @@ namespace VisualAlgo
         Matrix m = Matrix::eye(2, 3);
         CHECK_EQUAL(2, m.rows);
         CHECK_EQUAL(3, m.cols);
-        CHECK_EQUAL(1, m.data[0][0]);
-        CHECK_EQUAL(0, m.data[0][1]);
-        CHECK_EQUAL(0, m.data[0][2]);
-        CHECK_EQUAL(0, m.data[1][0]);
-        CHECK_EQUAL(1, m.data[1][1]);
-        CHECK_EQUAL(0, m.data[1][2]);
+        CHECK_EQUAL(1, m[0][0]);
+        CHECK_EQUAL(0, m[0][1]);
+        CHECK_EQUAL(0, m[0][2]);
+        CHECK_EQUAL(0, m[1][0]);
+        CHECK_EQUAL(1, m[1][1]);
+        CHECK_EQUAL(0, m[1][2]);
     }
 
     TEST(MatrixTestSuite, MatrixRandomWithRange)
@@ -1002,12 +1089,12 @@ namespace VisualAlgo
         Matrix c = Matrix::elementwise_max(a, b);
         CHECK_EQUAL(2, c.rows);
         CHECK_EQUAL(3, c.cols);
-        CHECK_EQUAL(2, c.data[0][0]);
-        CHECK_EQUAL(3, c.data[0][1]);
-        CHECK_EQUAL(4, c.data[0][2]);
-        CHECK_EQUAL(5, c.data[1][0]);
-        CHECK_EQUAL(6, c.data[1][1]);
-        CHECK_EQUAL(7, c.data[1][2]);
+        CHECK_EQUAL(2, c[0][0]);
+        CHECK_EQUAL(3, c[0][1]);
+        CHECK_EQUAL(4, c[0][2]);
+        CHECK_EQUAL(5, c[1][0]);
+        CHECK_EQUAL(6, c[1][1]);
+        CHECK_EQUAL(7, c[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -1030,12 +1117,12 @@ namespace VisualAlgo
         Matrix c = Matrix::elementwise_min(a, b);
         CHECK_EQUAL(2, c.rows);
         CHECK_EQUAL(3, c.cols);
-        CHECK_EQUAL(2, c.data[0][0]);
-        CHECK_EQUAL(2, c.data[0][1]);
-        CHECK_EQUAL(3, c.data[0][2]);
-        CHECK_EQUAL(4, c.data[1][0]);
-        CHECK_EQUAL(-9, c.data[1][1]);
-        CHECK_EQUAL(-3, c.data[1][2]);
+        CHECK_EQUAL(2, c[0][0]);
+        CHECK_EQUAL(2, c[0][1]);
+        CHECK_EQUAL(3, c[0][2]);
+        CHECK_EQUAL(4, c[1][0]);
+        CHECK_EQUAL(-9, c[1][1]);
+        CHECK_EQUAL(-3, c[1][2]);
 
         bool exceptionThrown = false;
         try
@@ -0,0 +1,208 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/MatrixView.hpp"
+#include "helpers/Convolution.hpp"
+#include "helpers/Simd.hpp"
+#include "FeatureExtraction/Filter.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace VisualAlgo
+{
+    TEST(MatrixViewTestSuite, MatrixViewFromMatrix)
+    {
+        Matrix m({{1, 2, 3}, {4, 5, 6}});
+        MatrixView v = m;
+        CHECK_EQUAL(2, v.rows);
+        CHECK_EQUAL(3, v.cols);
+        CHECK_EQUAL(3, v.stride);
+        CHECK(v.data == m.data.data());
+        CHECK(v.is_contiguous());
+        CHECK_EQUAL(5, v.get(1, 1));
+        CHECK_EQUAL(6, v[1][2]);
+
+        // The view sees writes made through the matrix.
+        m.set(1, 1, 50);
+        CHECK_EQUAL(50, v.get(1, 1));
+    }
+
+    TEST(MatrixViewTestSuite, MatrixViewSubmatrix)
+    {
+        Matrix m({{1, 2, 3, 4},
+                  {5, 6, 7, 8},
+                  {9, 10, 11, 12}});
+        MatrixView v = m.view(1, 3, 1, 3);
+        CHECK_EQUAL(2, v.rows);
+        CHECK_EQUAL(2, v.cols);
+        CHECK_EQUAL(4, v.stride);
+        CHECK(!v.is_contiguous());
+        CHECK(v.data == &m[1][1]);
+        CHECK(v.to_matrix() == Matrix({{6, 7}, {10, 11}}));
+        CHECK(v.to_matrix() == m.submatrix(1, 3, 1, 3));
+
+        // Views of views keep the parent stride.
+        MatrixView w = v.submatrix(1, 2, 0, 2);
+        CHECK_EQUAL(4, w.stride);
+        CHECK(w.to_matrix() == Matrix({{10, 11}}));
+
+        bool exceptionThrown = false;
+        try
+        {
+            v.get(2, 0);
+        }
+        catch (const std::out_of_range &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+
+        exceptionThrown = false;
+        try
+        {
+            m.view(0, 4, 0, 1);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    TEST(MatrixViewTestSuite, MatrixViewCrossCorrelate)
+    {
+        Matrix m = Matrix::random(12, 15, -1, 1);
+        Matrix kernel({{1, 2, 1},
+                       {0, 1, 0},
+                       {-1, -2, -1}});
+        MatrixView roi = m.view(2, 10, 3, 14);
+        Matrix copy = m.submatrix(2, 10, 3, 14);
+
+        CHECK(roi.cross_correlate(kernel).is_close(copy.cross_correlate(kernel)));
+        CHECK(roi.cross_correlate(kernel, 1, 2).is_close(copy.cross_correlate(kernel, 1, 2)));
+        CHECK(roi.convolve(kernel).is_close(copy.convolve(kernel)));
+    }
+
+    // Correlating over a padded copy must give exactly the same result as
+    // remapping every tap, on every instruction set. Kernels large enough for
+    // the FFT path only match up to rounding, and exactly with the direct method.
+    TEST(MatrixViewTestSuite, MatrixViewCrossCorrelateMatchesReference)
+    {
+        Matrix m = Matrix::random(23, 37, -1, 1);
+
+        auto reference_padded = [&](const Matrix &kernel, int padding, int stride)
+        {
+            Matrix output((m.rows + 2 * padding - kernel.rows) / stride + 1, (m.cols + 2 * padding - kernel.cols) / stride + 1);
+            for (int i = 0; i < output.rows; i++)
+                for (int j = 0; j < output.cols; j++)
+                {
+                    float sum = 0;
+                    for (int p = 0; p < kernel.rows; p++)
+                        for (int q = 0; q < kernel.cols; q++)
+                        {
+                            int y = stride * i + p - padding, x = stride * j + q - padding;
+                            if (y >= 0 && y < m.rows && x >= 0 && x < m.cols)
+                                sum += m.get(y, x) * kernel.get(p, q);
+                        }
+                    output.set(i, j, sum);
+                }
+            return output;
+        };
+
+        auto reference_same_size = [&](const Matrix &kernel, BorderMode border, float value)
+        {
+            Matrix output(m.rows, m.cols);
+            for (int i = 0; i < m.rows; i++)
+                for (int j = 0; j < m.cols; j++)
+                {
+                    float sum = 0;
+                    for (int p = 0; p < kernel.rows; p++)
+                        for (int q = 0; q < kernel.cols; q++)
+                        {
+                            int y = border_index(i + p - kernel.rows / 2, m.rows, border);
+                            int x = border_index(j + q - kernel.cols / 2, m.cols, border);
+                            sum += (y < 0 || x < 0 ? value : m.get(y, x)) * kernel.get(p, q);
+                        }
+                    output.set(i, j, sum);
+                }
+            return output;
+        };
+
+        for (Simd::Isa isa : {Simd::Isa::SCALAR, Simd::Isa::SSE4, Simd::Isa::AVX2, Simd::Isa::AVX512})
+        {
+            if (!Simd::is_supported(isa))
+                continue;
+            Simd::set_isa(isa);
+            for (auto [kernel_rows, kernel_cols] : {std::pair{1, 1}, {3, 3}, {4, 6}, {7, 1}, {1, 9}, {15, 21}})
+            {
+                Matrix kernel = Matrix::random(kernel_rows, kernel_cols, -1, 1);
+                auto matches = [&](const Matrix &result, const Matrix &expected, int stride)
+                {
+                    if (Convolution::choose_method(kernel, stride) == Convolution::Method::DIRECT)
+                        return result == expected;
+                    return result.is_close(expected, 1e-4);
+                };
+                for (BorderMode border : {BorderMode::CONSTANT, BorderMode::REPLICATE, BorderMode::REFLECT, BorderMode::REFLECT_101, BorderMode::WRAP})
+                {
+                    Matrix expected = reference_same_size(kernel, border, 0.5f);
+                    CHECK(matches(m.cross_correlate(kernel, border, 0.5f), expected, 1));
+                    CHECK(Convolution::cross_correlate(m, kernel, border, 0.5f, Convolution::Method::DIRECT) == expected);
+                }
+                CHECK(matches(m.cross_correlate(kernel), reference_same_size(kernel, BorderMode::REFLECT_101, 0), 1));
+                for (int padding : {0, 1, 5})
+                    for (int stride : {1, 2, 3})
+                        CHECK(matches(m.cross_correlate(kernel, padding, stride), reference_padded(kernel, padding, stride), stride));
+            }
+        }
+        Simd::set_isa(Simd::best_isa());
+    }
+
+    TEST(MatrixViewTestSuite, MatrixViewSeparableKernels)
+    {
+        Matrix column, row;
+        Matrix sobel({{1, 0, -1},
+                      {2, 0, -2},
+                      {1, 0, -1}});
+        CHECK(separate_kernel(sobel, column, row));
+        CHECK((column.matmul(row)).is_close(sobel, 1e-6));
+        CHECK(!separate_kernel(Matrix({{1, 2}, {3, 4}}), column, row));
+        CHECK(!separate_kernel(Matrix(3, 3, 0), column, row));
+
+        // The automatic and the explicit separable paths agree with a dense 2D pass
+        Matrix m = Matrix::random(31, 26, -1, 1);
+        Matrix u = Matrix::random(7, 1, -1, 1), v = Matrix::random(1, 5, -1, 1);
+        Matrix kernel = u.matmul(v);
+        for (BorderMode border : {BorderMode::CONSTANT, BorderMode::REPLICATE, BorderMode::REFLECT, BorderMode::REFLECT_101, BorderMode::WRAP})
+        {
+            Matrix automatic = m.cross_correlate(kernel, border);
+            CHECK(automatic.is_close(m.cross_correlate_separable(u, v, border), 1e-5));
+            CHECK(m.convolve(kernel, border).is_close(m.convolve_separable(u, v, border), 1e-5));
+        }
+
+        Matrix padded = m.cross_correlate(kernel, 2, 1);
+        Matrix expected(padded.rows, padded.cols);
+        for (int i = 0; i < expected.rows; i++)
+            for (int j = 0; j < expected.cols; j++)
+            {
+                float sum = 0;
+                for (int p = 0; p < kernel.rows; p++)
+                    for (int q = 0; q < kernel.cols; q++)
+                    {
+                        int y = i + p - 2, x = j + q - 2;
+                        if (y >= 0 && y < m.rows && x >= 0 && x < m.cols)
+                            sum += m.get(y, x) * kernel.get(p, q);
+                    }
+                expected.set(i, j, sum);
+            }
+        CHECK(padded.is_close(expected, 1e-5));
+    }
+
+    TEST(MatrixViewTestSuite, MatrixViewFilter)
+    {
+        Matrix m = Matrix::random(20, 20);
+        FeatureExtraction::GaussianFilter g(1.0f);
+        Matrix expected = g.apply(m.submatrix(5, 15, 4, 16));
+        Matrix actual = g.apply(m.view(5, 15, 4, 16));
+        CHECK(actual.is_close(expected));
+    }
+}
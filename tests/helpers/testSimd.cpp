@@ -0,0 +1,132 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/Simd.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace VisualAlgo
+{
+    // Compares every instruction set the CPU supports against the scalar
+    // fallback. 67 elements leaves a tail for every vector width.
+    TEST(SimdTestSuite, SimdKernelsMatchScalar)
+    {
+        const size_t n = 67;
+        Matrix a = Matrix::random(1, n, -10, 10);
+        Matrix b = Matrix::random(1, n, 1, 10);
+        a.set(0, 5, 0);
+        b.set(0, 5, 0);
+        a.set(0, 66, b.get(0, 66));
+        Matrix divisor = b + 1.0f; // no 0 / 0, NaN is never equal to itself
+
+        auto run_all = [&]()
+        {
+            std::vector<Matrix> results;
+            results.push_back(Matrix::elementwise_max(a, b));
+            results.push_back(Matrix::elementwise_min(a, b));
+            results.push_back(a > b);
+            results.push_back(a < b);
+            results.push_back(a >= b);
+            results.push_back(a <= b);
+            results.push_back(a > 0.5f);
+            results.push_back(a <= 0.5f);
+            results.push_back(a + b);
+            results.push_back(a - b);
+            results.push_back(a * b);
+            results.push_back(a / divisor);
+            results.push_back(a - 1.5f);
+            results.push_back(3.0f * a);
+            results.push_back(Matrix(a) / 3.0f);
+            Matrix c = a;
+            c += b;
+            c -= 1.5f;
+            c *= b;
+            c /= 3.0f;
+            results.push_back(c);
+            Matrix d = a;
+            d.relu();
+            results.push_back(d);
+            d = a;
+            d.abs();
+            results.push_back(d);
+            d = a;
+            d.normalize255();
+            results.push_back(d);
+            Matrix e(1, n);
+            Simd::combine3(a[0], b[0], c[0], e[0], n, 0.25f, -0.5f, 2.0f, 128.0f);
+            results.push_back(e);
+            results.push_back(Matrix({{a.max(), a.min(), b.max(), b.min()}}));
+            results.push_back(Matrix({{a.sum(), a.dot(b)}}));
+            return results;
+        };
+
+        Simd::set_isa(Simd::Isa::SCALAR);
+        CHECK(Simd::active_isa() == Simd::Isa::SCALAR);
+        std::vector<Matrix> expected = run_all();
+
+        for (Simd::Isa isa : {Simd::Isa::SSE4, Simd::Isa::AVX2, Simd::Isa::AVX512})
+        {
+            if (!Simd::is_supported(isa))
+                continue;
+            Simd::set_isa(isa);
+            std::vector<Matrix> results = run_all();
+            for (size_t i = 0; i + 1 < results.size(); i++)
+                CHECK(results[i] == expected[i]);
+            // sum and dot accumulate in a different order
+            CHECK(results.back().is_close(expected.back(), 1e-3));
+        }
+
+        Simd::set_isa(Simd::best_isa());
+    }
+
+    // The unrolled kernels give the same bits as correlate_row row by row,
+    // on every instruction set
+    TEST(SimdTestSuite, CorrelateSquareMatchesRows)
+    {
+        const size_t n = 67;
+        for (int size : {3, 5})
+        {
+            Matrix input = Matrix::random(size, n + size - 1, -1, 1);
+            Matrix kernel = Matrix::random(size, size, -1, 1);
+            std::vector<const float *> rows;
+            for (int p = 0; p < size; p++)
+                rows.push_back(input[p]);
+
+            for (Simd::Isa isa : {Simd::Isa::SCALAR, Simd::Isa::SSE4, Simd::Isa::AVX2, Simd::Isa::AVX512})
+            {
+                if (!Simd::is_supported(isa))
+                    continue;
+                Simd::set_isa(isa);
+                Matrix expected(1, n, 0.5f), result(1, n, 0.5f);
+                for (int p = 0; p < size; p++)
+                    Simd::correlate_row(input[p], kernel[p], size, expected[0], n);
+                Simd::correlate_square(rows.data(), kernel.data.data(), size, result[0], n);
+                CHECK(result == expected);
+            }
+        }
+        Simd::set_isa(Simd::best_isa());
+
+        CHECK(Simd::has_correlate_square(3) && !Simd::has_correlate_square(4));
+        bool exceptionThrown = false;
+        try
+        {
+            Matrix input = Matrix::random(4, 10, -1, 1), kernel = Matrix::random(4, 4, -1, 1), out(1, 7);
+            const float *rows[] = {input[0], input[1], input[2], input[3]};
+            Simd::correlate_square(rows, kernel.data.data(), 4, out[0], 7);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+
+    TEST(SimdTestSuite, SimdIsaSelection)
+    {
+        CHECK(Simd::is_supported(Simd::Isa::SCALAR));
+        CHECK(Simd::is_supported(Simd::best_isa()));
+        CHECK_EQUAL("scalar", Simd::to_string(Simd::Isa::SCALAR));
+        CHECK_EQUAL("avx2", Simd::to_string(Simd::Isa::AVX2));
+    }
+}
@@ -0,0 +1,81 @@
+#include "TestHarness.h"
+#include "helpers/Matrix.hpp"
+#include "helpers/SmallMatrix.hpp"
+
+#include <stdexcept>
+
+namespace VisualAlgo
+{
+    // Everything below the static_asserts is also usable at compile time
+    static_assert(Matrix3::identity() * Matrix3::identity() == Matrix3::identity());
+    static_assert(Matrix3({{2, 0, 0}, {0, 4, 0}, {0, 0, 1}}).inverse() == Matrix3({{0.5, 0, 0}, {0, 0.25, 0}, {0, 0, 1}}));
+
+    TEST(SmallMatrixTestSuite, SmallMatrixProduct)
+    {
+        SmallMatrix<2, 3> a{{1, 2, 3}, {4, 5, 6}};
+        SmallMatrix<3, 2> b{{10, 11}, {20, 21}, {30, 31}};
+        SmallMatrix<2, 2> c = a * b;
+        CHECK(c.to_matrix() == a.to_matrix().matmul(b.to_matrix()));
+
+        Matrix3 translation{{1, 0, 5}, {0, 1, -2}, {0, 0, 1}};
+        Vector3 point{{3}, {4}, {1}};
+        CHECK((translation * point) == Vector3({{8}, {2}, {1}}));
+        CHECK_EQUAL(3, a.transpose().rows);
+        CHECK_EQUAL(6, a.transpose().get(2, 1));
+    }
+
+    TEST(SmallMatrixTestSuite, SmallMatrixInverse)
+    {
+        Matrix3 m{{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+        CHECK_DOUBLES_EQUAL(-3, m.det(), 1e-5);
+        CHECK((m * m.inverse()).is_close(Matrix3::identity(), 1e-5));
+        CHECK(m.inverse().to_matrix().is_close(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 10}}).inverse(), 1e-5));
+
+        SmallMatrix<4, 4> n{{4, 1, 0, 0}, {1, 4, 1, 0}, {0, 1, 4, 1}, {0, 0, 1, 4}};
+        CHECK_DOUBLES_EQUAL(209, n.det(), 1e-3);
+        CHECK((n * n.inverse()).is_close(SmallMatrix<4, 4>::identity(), 1e-5));
+
+        bool exceptionThrown = false;
+        try
+        {
+            Matrix3{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}.inverse();
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK_EQUAL(true, exceptionThrown);
+    }
+
+    TEST(SmallMatrixTestSuite, SmallMatrixFromMatrix)
+    {
+        Matrix m({{1, 2}, {3, 4}});
+        SmallMatrix<2, 2> s(m);
+        CHECK_EQUAL(4, s.get(1, 1));
+        CHECK(s.to_matrix() == m);
+        Matrix converted = s;
+        CHECK(converted == m);
+
+        bool exceptionThrown = false;
+        try
+        {
+            Matrix3 t(m);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK_EQUAL(true, exceptionThrown);
+
+        exceptionThrown = false;
+        try
+        {
+            s.get(2, 0);
+        }
+        catch (const std::out_of_range &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK_EQUAL(true, exceptionThrown);
+    }
+}
@@ -0,0 +1,72 @@
+#include "TestHarness.h"
+#include "helpers/ThreadPool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace VisualAlgo
+{
+    TEST(ThreadPoolTestSuite, ThreadPoolRunsEveryTask)
+    {
+        for (int threads : {1, 4})
+        {
+            ThreadPool pool(threads);
+            CHECK_EQUAL(threads, pool.size());
+            for (int count : {0, 1, 3, 100})
+            {
+                std::vector<std::atomic<int>> runs(count);
+                pool.parallel_for(count, [&](int i)
+                                  { runs[i]++; });
+                for (int i = 0; i < count; i++)
+                    CHECK_EQUAL(1, runs[i].load());
+            }
+        }
+        CHECK(ThreadPool::global().size() >= 1);
+    }
+
+    // The caller works on its own loop, so loops inside tasks cannot wait
+    // for workers that are all busy
+    TEST(ThreadPoolTestSuite, ThreadPoolNestedLoops)
+    {
+        ThreadPool pool(3);
+        std::atomic<int> total = 0;
+        pool.parallel_for(8, [&](int i)
+                          { pool.parallel_for(10, [&](int j)
+                                              { total += i * 10 + j; }); });
+        CHECK_EQUAL(79 * 80 / 2, total.load());
+    }
+
+    TEST(ThreadPoolTestSuite, ThreadPoolRethrows)
+    {
+        ThreadPool pool(4);
+        std::atomic<int> runs = 0;
+        bool exceptionThrown = false;
+        try
+        {
+            pool.parallel_for(50, [&](int i)
+                              {
+                                  runs++;
+                                  if (i == 7)
+                                      throw std::runtime_error("Task failed.");
+                              });
+        }
+        catch (const std::runtime_error &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+        CHECK_EQUAL(50, runs.load());
+
+        exceptionThrown = false;
+        try
+        {
+            ThreadPool negative(-1);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            exceptionThrown = true;
+        }
+        CHECK(exceptionThrown);
+    }
+}